@@ -0,0 +1,134 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+namespace HuyNPhysic {
+
+    // Heap allocations counted per phase of the step.
+    // Builds with HUYN_PHYSIC_TRACK_ALLOCATIONS (CMake option PHYSIC_TRACK_ALLOCATIONS) link src/AllocationHooks.cpp,
+    // whose global operator new reports every allocation here, charged to the phase the allocating thread is in.
+    // Otherwise the phase markers compile to nothing and the counters stay at zero.
+    // Counters are process wide: with several worlds stepping at once, their allocations add up.
+
+    enum class AllocationPhase : std::uint8_t {
+        Other,                          // anything outside a marked phase, including pool workers
+        Integration,                    // integrator and force field
+        Boundaries,                     // window bounds and static walls
+        Contacts,                       // broad and narrow phase
+        Solver,
+        Diagnostics,
+        Snapshot,                       // copying state out for the renderer
+        Rewind,                         // recording into a RewindBuffer
+        Count
+    };
+
+    [[nodiscard]] constexpr const char* AllocationPhaseName(const AllocationPhase phase) noexcept {
+        constexpr const char* names[] = {"other", "integration", "boundaries", "contacts", "solver",
+                                         "diagnostics", "snapshot", "rewind"};
+        return names[static_cast<std::size_t>(phase)];
+    }
+
+    constexpr std::size_t AllocationPhaseCount = static_cast<std::size_t>(AllocationPhase::Count);
+
+#ifdef HUYN_PHYSIC_TRACK_ALLOCATIONS
+    constexpr bool AllocationTrackingEnabled = true;
+#else
+    constexpr bool AllocationTrackingEnabled = false;
+#endif
+
+    struct AllocationCounts {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    // Totals since start-up; the difference of two readings gives what happened in between
+    struct AllocationStats {
+        std::array<AllocationCounts, AllocationPhaseCount> phases{};
+
+        [[nodiscard]] const AllocationCounts& operator[](const AllocationPhase phase) const noexcept {
+            return phases[static_cast<std::size_t>(phase)];
+        }
+
+        [[nodiscard]] AllocationCounts Total() const noexcept {
+            AllocationCounts total;
+            for (const auto& p : phases) {
+                total.allocations += p.allocations;
+                total.bytes += p.bytes;
+            }
+            return total;
+        }
+
+        [[nodiscard]] AllocationStats operator-(const AllocationStats& earlier) const noexcept {
+            AllocationStats d;
+            for (std::size_t i = 0; i < AllocationPhaseCount; i++) {
+                d.phases[i].allocations = phases[i].allocations - earlier.phases[i].allocations;
+                d.phases[i].bytes = phases[i].bytes - earlier.phases[i].bytes;
+            }
+            return d;
+        }
+
+        AllocationStats& operator+=(const AllocationStats& other) noexcept {
+            for (std::size_t i = 0; i < AllocationPhaseCount; i++) {
+                phases[i].allocations += other.phases[i].allocations;
+                phases[i].bytes += other.phases[i].bytes;
+            }
+            return *this;
+        }
+    };
+
+    namespace AllocationTracking {
+        inline std::array<std::atomic<std::uint64_t>, AllocationPhaseCount> allocations{};
+        inline std::array<std::atomic<std::uint64_t>, AllocationPhaseCount> bytes{};
+        inline thread_local AllocationPhase currentPhase = AllocationPhase::Other;
+
+        // Called by the operator new replacements; must not allocate
+        inline void Record(const std::size_t size) noexcept {
+            const auto phase = static_cast<std::size_t>(currentPhase);
+            allocations[phase].fetch_add(1, std::memory_order_relaxed);
+            bytes[phase].fetch_add(size, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] inline AllocationStats Read() noexcept {
+            AllocationStats stats;
+            for (std::size_t i = 0; i < AllocationPhaseCount; i++) {
+                stats.phases[i].allocations = allocations[i].load(std::memory_order_relaxed);
+                stats.phases[i].bytes = bytes[i].load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+    }
+
+    // Charges this thread's allocations to a phase until the end of the scope
+    class AllocationPhaseScope {
+    public:
+        explicit AllocationPhaseScope(const AllocationPhase phase) noexcept : previous(AllocationTracking::currentPhase) {
+            AllocationTracking::currentPhase = phase;
+        }
+        ~AllocationPhaseScope() { AllocationTracking::currentPhase = previous; }
+
+        AllocationPhaseScope(const AllocationPhaseScope&) = delete;
+        AllocationPhaseScope& operator=(const AllocationPhaseScope&) = delete;
+
+    private:
+        AllocationPhase previous;
+    };
+
+}
+
+#ifdef HUYN_PHYSIC_TRACK_ALLOCATIONS
+#define HUYN_PHYSIC_ALLOCATION_PHASE(phase) \
+    const ::HuyNPhysic::AllocationPhaseScope allocationPhaseScope_(::HuyNPhysic::AllocationPhase::phase)
+#else
+#define HUYN_PHYSIC_ALLOCATION_PHASE(phase) static_cast<void>(0)
+#endif
+
+#endif //ALLOCATIONTRACKER_H
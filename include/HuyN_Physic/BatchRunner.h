@@ -0,0 +1,70 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "World.h"
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    template<typename T>
+    struct WorldSummary {
+        std::uint64_t ticks{};          // world tick after the run
+        std::size_t bodies{};
+        std::size_t contacts{};         // contacts solved in the last step
+        T kineticEnergy{};
+        Vector2<T> momentum{};
+        T maxSpeed{};
+        double seconds{};               // wall time spent stepping this world
+    };
+
+    template<typename T, typename IntegratorPolicy, typename Forces>
+    WorldSummary<T> Summarize(const World<T, IntegratorPolicy, Forces>& world, const double seconds) {
+        WorldSummary<T> summary{world.tick, world.objects.size(), world.solver.contacts.size(),
+                                0, Vector2<T>{}, 0, seconds};
+        for (const auto& o : world.objects) {
+            const T speedSquared = o.velocity.dot(o.velocity);
+            summary.kineticEnergy += o.mass * speedSquared / 2;
+            summary.momentum += o.velocity * o.mass;
+            summary.maxSpeed = std::max(summary.maxSpeed, speedSquared);
+        }
+        using std::sqrt;
+        summary.maxSpeed = sqrt(summary.maxSpeed);
+        return summary;
+    }
+
+
+    // ************************************** BATCH RUNNER ************************************** //
+
+    // Advances every world by the same number of ticks, one world per task, and returns one summary per world
+    // in the same order. Worlds are independent, so there is no synchronisation inside a step; throughput
+    // comes from keeping every thread busy on its own world.
+    template<typename T, typename IntegratorPolicy, typename Forces>
+    std::vector<WorldSummary<T>> RunBatch(std::vector<World<T, IntegratorPolicy, Forces>>& worlds, const std::uint64_t ticks,
+                                          ThreadPool& pool) {
+        std::vector<WorldSummary<T>> summaries(worlds.size());
+
+        pool.ParallelFor(worlds.size(), [&](const std::size_t i) {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::uint64_t t = 0; t < ticks; t++) worlds[i].Step();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            summaries[i] = Summarize(worlds[i], elapsed.count());
+        });
+
+        return summaries;
+    }
+
+}
+
+#endif //BATCHRUNNER_H
@@ -0,0 +1,487 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "QuadTree.h"
+#include "AllocationTracker.h"
+#include "PhysicEngine.h"
+#include "ContactSolver.h"
+#include "Integrator.h"
+#include "ForceField.h"
+
+#ifndef CHUNKEDWORLD_H
+#define CHUNKEDWORLD_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    // An unbounded world cut into square chunks of chunkSize px, each with its own quadtree over the bodies
+    // whose centre lies in it. Only awake chunks are simulated. Chunks within wakeRadius of the camera are
+    // always awake; the others freeze once their bodies settle, or as soon as they are beyond freezeRadius.
+    // Frozen chunks keep their bodies in memory until more than maxResidentChunks are frozen, then the
+    // longest frozen ones are written to pageDirectory and dropped. Page files are named after the process and
+    // the instance, so worlds sharing a directory never touch each other's pages. A chunk wakes (and is read back) when the
+    // camera comes near or when an awake body moves into it.
+    //
+    // Bodies only meet bodies of awake chunks, and must be smaller than a chunk. There are no bounds, floor
+    // or walls, so the default field has no gravity: large maps are seen from the top.
+    template<typename T, typename IntegratorPolicy = Integrator::VelocityVerlet, typename Forces = DefaultForceField<T>>
+    class ChunkedWorld {
+    public:
+        enum class ChunkState : std::uint8_t { Awake, Frozen, Paged };
+
+        struct Chunk {
+            std::int32_t x, y;          // chunk coordinates: the chunk covers [x, x + 1) * chunkSize, same for y
+            ChunkState state = ChunkState::Awake;
+            std::vector<Object<T>> bodies{};    // while frozen; awake bodies live in objects, paged ones on disk
+            std::size_t bodyCount = 0;  // in any state
+            std::uint64_t frozenAt = 0; // tick; the oldest frozen chunks are paged first
+            bool moving = false;        // some body faster than sleepSpeed on the last step
+            QuadTree::QuadTree<T> index;
+
+            Chunk(const std::int32_t x_, const std::int32_t y_, const T size) :
+                x(x_), y(y_), index(Shape::Box<T>{T(x_) * size, T(y_) * size, size, size}) {}
+        };
+
+        std::vector<Object<T>> objects{};      // bodies of the awake chunks
+
+        T chunkSize;                    // px
+        Vector2<T> camera{};
+        T wakeRadius;                   // px around the camera
+        T freezeRadius;                 // px; chunks further away freeze even while moving
+        T sleepSpeed = 1;               // px/s
+        std::size_t maxResidentChunks = 256;    // frozen chunks kept in memory
+        std::string pageDirectory = ".";
+        std::uint64_t freezeInterval = 32;      // steps between freeze and paging sweeps
+
+        Vector2<T> gravity{};
+        IntegratorPolicy integrator{};
+        Forces forces{};
+        std::uint64_t tickInterval = 10; // ms per step
+        std::uint64_t tick = 0;
+
+        ContactSolver<T> solver{8};
+
+        ChunkedWorld(T chunkSize_, T wakeRadius_, T freezeRadius_) :
+            chunkSize(chunkSize_), wakeRadius(wakeRadius_), freezeRadius(std::max(freezeRadius_, wakeRadius_)) {}
+
+        ChunkedWorld(const ChunkedWorld&) = delete;
+        ChunkedWorld& operator=(const ChunkedWorld&) = delete;
+
+        ~ChunkedWorld() {
+            for (const auto& [key, chunk] : chunks) {
+                if (chunk.state == ChunkState::Paged) std::remove(PagePath(chunk).c_str());
+            }
+        }
+
+        // ********************************* BODY MANAGEMENT ********************************* //
+
+        static constexpr std::uint32_t NoIndex = NoBodyIndex;
+
+        // Index into objects, or NoIndex if the body is frozen, paged or unknown
+        [[nodiscard]] std::uint32_t IndexOf(const std::uint32_t id) const noexcept {
+            return id < indexOfId.size() ? indexOfId[id] : NoIndex;
+        }
+
+        // Adds the body awake, waking its chunk. Returns its id.
+        std::uint32_t AddBody(const Object<T>& body) {
+            const auto [cx, cy] = ChunkCoordinates(body.x, body.y);
+            Wake(FindOrCreate(cx, cy));
+            objects.push_back(body);
+            objects.back().id = nextId;
+            indexOfId.resize(nextId + 1, NoIndex);
+            indexOfId[nextId] = static_cast<std::uint32_t>(objects.size() - 1);
+            ++totalBodies;
+            accelerationsValid = false;
+            return nextId++;
+        }
+
+        [[nodiscard]] std::pair<std::int32_t, std::int32_t> ChunkCoordinates(const T x, const T y) const {
+            using std::floor;
+            return {static_cast<std::int32_t>(floor(x / chunkSize)), static_cast<std::int32_t>(floor(y / chunkSize))};
+        }
+
+        [[nodiscard]] const Chunk* FindChunk(const std::int32_t cx, const std::int32_t cy) const {
+            const auto it = chunks.find(ChunkKey(cx, cy));
+            return it == chunks.end() ? nullptr : &it->second;
+        }
+
+        // Includes bodies of paged chunks, also those whose page could not be read back (see PageInFailures)
+        [[nodiscard]] std::size_t BodyCount() const noexcept { return totalBodies; }
+        [[nodiscard]] std::size_t ChunkCount() const noexcept { return chunks.size(); }
+        [[nodiscard]] std::size_t AwakeChunkCount() const noexcept { return awake.size(); }
+        [[nodiscard]] std::size_t PagedChunkCount() const noexcept { return pagedChunks; }
+
+        // Failed attempts to read a paged chunk back. Its bodies stay out of the simulation and the chunk stays
+        // paged, so a later wake tries again.
+        [[nodiscard]] std::uint64_t PageInFailures() const noexcept { return pageInFailures; }
+
+        // ************************************ SIMULATION ************************************ //
+
+        void ComputeAccelerations(std::vector<Object<T>>& bodies, const std::vector<std::uint32_t>* active = nullptr) const {
+            const ForceContext<T> context{gravity, std::numeric_limits<T>::max(),
+                                          Integrator::TickToSeconds(static_cast<T>(tickInterval)), &indexOfId};
+            forces.Compute(bodies, context, active);
+        }
+
+        void Step() {
+            WakeNearCamera();
+            if (tick >= nextFreezeSweep) {
+                FreezeSettled();
+                PageOut();
+                nextFreezeSweep = tick + freezeInterval;
+            }
+
+            auto computeAccelerations = [this](std::vector<Object<T>>& bodies,
+                                               const std::vector<std::uint32_t>* active = nullptr) {
+                ComputeAccelerations(bodies, active);
+            };
+            {
+                HUYN_PHYSIC_ALLOCATION_PHASE(Integration);
+                if (!accelerationsValid) {
+                    computeAccelerations(objects);
+                    accelerationsValid = true;
+                }
+                integrator.Step(objects, static_cast<T>(tickInterval), computeAccelerations);
+            }
+            {
+                HUYN_PHYSIC_ALLOCATION_PHASE(Contacts);
+                Rebucket();
+                solver.BeginStep();
+                FindContacts();
+            }
+            {
+                HUYN_PHYSIC_ALLOCATION_PHASE(Solver);
+                solver.Solve(objects, static_cast<T>(tickInterval), tick + 1);
+            }
+
+            ++tick;
+        }
+
+        // ************************************** PAGING ************************************** //
+
+        // Writes a frozen chunk to disk and frees its bodies. Returns false if it could not be written,
+        // in which case the chunk stays in memory.
+        bool PageOutChunk(Chunk& chunk) {
+            if (chunk.state != ChunkState::Frozen) return false;
+            static_assert(std::is_trivially_copyable_v<T>, "page files store scalars as raw bytes");
+
+            std::vector<std::uint8_t> data;
+            auto put = [&data](const auto& value) {
+                const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+                data.insert(data.end(), bytes, bytes + sizeof(value));
+            };
+            put(PageMagic);
+            put(PageVersion);
+            put(static_cast<std::uint32_t>(sizeof(T)));
+            put(static_cast<std::uint64_t>(chunk.bodies.size()));
+            for (const Object<T>& body : chunk.bodies) {
+                const char type = body.shape->getType();
+                T sizeX = 0, sizeY = 0;
+                if (type == 'c') {
+                    sizeX = sizeY = dynamic_cast<Shape::Circle<T>*>(body.shape)->radius;
+                } else if (type == 'b') {
+                    auto* box = dynamic_cast<Shape::Box<T>*>(body.shape);
+                    sizeX = box->width;
+                    sizeY = box->height;
+                }
+                put(body.id);
+                put(body.groups);
+                put(type);
+                put(body.x);
+                put(body.y);
+                put(body.velocity.x);
+                put(body.velocity.y);
+                put(body.acceleration.x);
+                put(body.acceleration.y);
+                put(body.mass);
+                put(sizeX);
+                put(sizeY);
+            }
+
+            std::FILE* file = std::fopen(PagePath(chunk).c_str(), "wb");
+            if (!file) return false;
+            const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+            if (std::fclose(file) != 0 || !written) {
+                std::remove(PagePath(chunk).c_str());
+                return false;
+            }
+
+            std::vector<Object<T>>().swap(chunk.bodies);
+            chunk.state = ChunkState::Paged;
+            ++pagedChunks;
+            return true;
+        }
+
+        // Reads a paged chunk back as frozen. Returns false if its file is missing or damaged.
+        bool PageInChunk(Chunk& chunk) {
+            if (chunk.state != ChunkState::Paged) return false;
+
+            std::FILE* file = std::fopen(PagePath(chunk).c_str(), "rb");
+            if (!file) return false;
+            std::vector<std::uint8_t> data;
+            std::uint8_t buffer[4096];
+            for (std::size_t n; (n = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) data.insert(data.end(), buffer, buffer + n);
+            std::fclose(file);
+
+            std::size_t offset = 0;
+            auto get = [&](auto& value) {
+                if (data.size() - offset < sizeof(value)) return false;
+                std::memcpy(&value, data.data() + offset, sizeof(value));
+                offset += sizeof(value);
+                return true;
+            };
+            std::uint32_t magic = 0, version = 0, scalarSize = 0;
+            std::uint64_t count = 0;
+            if (!get(magic) || !get(version) || !get(scalarSize) || !get(count) || magic != PageMagic ||
+                version != PageVersion || scalarSize != sizeof(T)) return false;
+
+            std::vector<Object<T>> bodies;
+            bodies.reserve(count);
+            for (std::uint64_t i = 0; i < count; i++) {
+                std::uint32_t id, groups;
+                char type;
+                T x, y, vx, vy, ax, ay, mass, sizeX, sizeY;
+                if (!get(id) || !get(groups) || !get(type) || !get(x) || !get(y) || !get(vx) || !get(vy) || !get(ax) || !get(ay) ||
+                    !get(mass) || !get(sizeX) || !get(sizeY)) return false;
+                if (type == 'c') {
+                    Shape::Circle<T> circle{x, y, sizeX};
+                    bodies.emplace_back(x, y, mass, &circle, vx, vy, ax, ay);
+                } else if (type == 'b') {
+                    Shape::Box<T> box{x, y, sizeX, sizeY};
+                    bodies.emplace_back(x, y, mass, &box, vx, vy, ax, ay);
+                } else {
+                    return false;
+                }
+                bodies.back().id = id;
+                bodies.back().groups = groups;
+            }
+
+            std::remove(PagePath(chunk).c_str());
+            chunk.bodies = std::move(bodies);
+            chunk.state = ChunkState::Frozen;
+            --pagedChunks;
+            return true;
+        }
+
+    private:
+        static constexpr std::uint32_t PageMagic = 0x4B43484E;     // "NHCK"
+        static constexpr std::uint32_t PageVersion = 2;            // 2: bodies carry their event groups
+
+        std::unordered_map<std::uint64_t, Chunk> chunks{};
+        std::vector<Chunk*> awake{};    // element pointers of an unordered_map survive rehashing
+        std::vector<Chunk*> chunkOfBody{};      // per object, filled by Rebucket; null if its chunk could not wake
+        std::vector<Chunk*> frozenChunks{};     // PageOut's scratch, kept so sweeps do not allocate
+        std::vector<std::uint32_t> indexOfId{};
+        std::uint32_t nextId = 0;
+        std::size_t totalBodies = 0;
+        std::size_t pagedChunks = 0;
+        std::uint64_t pageInFailures = 0;
+        std::string pageTag = MakePageTag();    // <pid>_<instance>
+        std::uint64_t nextFreezeSweep = 0;
+        bool accelerationsValid = false;
+
+        [[nodiscard]] static std::uint64_t ChunkKey(const std::int32_t cx, const std::int32_t cy) noexcept {
+            return static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32 | static_cast<std::uint32_t>(cy);
+        }
+
+        [[nodiscard]] static std::string MakePageTag() {
+            static std::atomic<std::uint64_t> instances{0};
+#ifdef _WIN32
+            const auto pid = static_cast<long long>(_getpid());
+#else
+            const auto pid = static_cast<long long>(getpid());
+#endif
+            return std::to_string(pid) + "_" + std::to_string(instances.fetch_add(1, std::memory_order_relaxed));
+        }
+
+        [[nodiscard]] std::string PagePath(const Chunk& chunk) const {
+            return pageDirectory + "/chunk_" + pageTag + "_" + std::to_string(chunk.x) + "_" + std::to_string(chunk.y) + ".bin";
+        }
+
+        Chunk& FindOrCreate(const std::int32_t cx, const std::int32_t cy) {
+            auto [it, created] = chunks.try_emplace(ChunkKey(cx, cy), cx, cy, chunkSize);
+            if (created) awake.push_back(&it->second);
+            return it->second;
+        }
+
+        // Distance from the camera to the nearest point of the chunk
+        [[nodiscard]] T CameraDistanceSquared(const Chunk& chunk) const {
+            const T left = T(chunk.x) * chunkSize, top = T(chunk.y) * chunkSize;
+            const T dx = std::max({left - camera.x, T(0), camera.x - (left + chunkSize)});
+            const T dy = std::max({top - camera.y, T(0), camera.y - (top + chunkSize)});
+            return dx * dx + dy * dy;
+        }
+
+        // Moves a frozen or paged chunk's bodies into objects. Returns false if its page could not be read.
+        bool Wake(Chunk& chunk) {
+            if (chunk.state == ChunkState::Awake) return true;
+            if (chunk.state == ChunkState::Paged && !PageInChunk(chunk)) {
+                ++pageInFailures;
+                return false;
+            }
+            for (auto& body : chunk.bodies) {
+                indexOfId[body.id] = static_cast<std::uint32_t>(objects.size());
+                objects.push_back(std::move(body));
+            }
+            chunk.bodies.clear();
+            chunk.state = ChunkState::Awake;
+            awake.push_back(&chunk);
+            accelerationsValid = false;     // frozen accelerations are stale
+            return true;
+        }
+
+        void WakeNearCamera() {
+            if (wakeRadius <= 0) return;
+            const auto [minX, minY] = ChunkCoordinates(camera.x - wakeRadius, camera.y - wakeRadius);
+            const auto [maxX, maxY] = ChunkCoordinates(camera.x + wakeRadius, camera.y + wakeRadius);
+            const T radiusSquared = wakeRadius * wakeRadius;
+            for (std::int32_t cy = minY; cy <= maxY; cy++) {
+                for (std::int32_t cx = minX; cx <= maxX; cx++) {
+                    const auto it = chunks.find(ChunkKey(cx, cy));
+                    if (it != chunks.end() && CameraDistanceSquared(it->second) <= radiusSquared) Wake(it->second);
+                }
+            }
+        }
+
+        // Files every awake body under the chunk its centre is in, waking chunks bodies moved into,
+        // and rebuilds the quadtrees of the awake chunks
+        void Rebucket() {
+            for (Chunk* chunk : awake) {
+                chunk->index.reset();
+                chunk->bodyCount = 0;
+                chunk->moving = false;
+            }
+
+            const T sleepSpeedSquared = sleepSpeed * sleepSpeed;
+            // Waking appends to objects, so the newcomers are filed by the same loop
+            chunkOfBody.clear();
+            for (std::size_t i = 0; i < objects.size(); i++) {
+                const auto [cx, cy] = ChunkCoordinates(objects[i].x, objects[i].y);
+                Chunk& chunk = FindOrCreate(cx, cy);
+                if (chunk.state != ChunkState::Awake) {
+                    if (!Wake(chunk)) {
+                        chunkOfBody.push_back(nullptr);
+                        continue;
+                    }
+                    chunk.bodyCount = 0;
+                    chunk.moving = false;
+                }
+                chunkOfBody.push_back(&chunk);
+                ++chunk.bodyCount;
+                if (objects[i].velocity.dot(objects[i].velocity) > sleepSpeedSquared) chunk.moving = true;
+                (void)chunk.index.insert(objects[i].Vector2Position(), static_cast<std::uint32_t>(i));
+            }
+        }
+
+        [[nodiscard]] static T HalfExtent(const Object<T>& body) {
+            const char type = body.shape->getType();
+            if (type == 'c') return dynamic_cast<Shape::Circle<T>*>(body.shape)->radius;
+            if (type == 'b') {
+                const auto* box = dynamic_cast<Shape::Box<T>*>(body.shape);
+                return std::max(box->width, box->height) / 2;
+            }
+            return 0;
+        }
+
+        // Broad phase: each body queries its own chunk and the eight around it for centres close enough to touch
+        void FindContacts() {
+            T maxExtent = 0;
+            for (const auto& body : objects) maxExtent = std::max(maxExtent, HalfExtent(body));
+
+            for (std::size_t i = 0; i < objects.size(); i++) {
+                const Chunk* home = chunkOfBody[i];
+                if (!home) continue;
+                const T reach = HalfExtent(objects[i]) + maxExtent;
+                const Shape::Box<T> range{objects[i].x - reach, objects[i].y - reach, reach * 2, reach * 2};
+                for (std::int32_t dy = -1; dy <= 1; dy++) {
+                    for (std::int32_t dx = -1; dx <= 1; dx++) {
+                        const auto it = chunks.find(ChunkKey(home->x + dx, home->y + dy));
+                        if (it == chunks.end() || it->second.state != ChunkState::Awake) continue;
+                        it->second.index.query(range, [&](const Vector2<T>&, const std::uint32_t j) {
+                            if (j > i) solver.AddContact(objects, i, j);
+                        });
+                    }
+                }
+            }
+        }
+
+        // Freezes awake chunks away from the camera that settled or drifted beyond freezeRadius.
+        // Empty chunks are dropped instead.
+        void FreezeSettled() {
+            const T wakeSquared = wakeRadius * wakeRadius, freezeSquared = freezeRadius * freezeRadius;
+            bool anyFrozen = false;
+            for (Chunk* chunk : awake) {
+                const T distanceSquared = CameraDistanceSquared(*chunk);
+                if (distanceSquared <= wakeSquared || (chunk->moving && distanceSquared <= freezeSquared)) continue;
+                chunk->state = ChunkState::Frozen;
+                chunk->frozenAt = tick;
+                chunk->index.clear();
+                anyFrozen = true;
+            }
+            if (!anyFrozen) return;
+
+            // Bodies of frozen chunks leave objects; the rest keep their order
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < objects.size(); i++) {
+                Chunk* chunk = i < chunkOfBody.size() ? chunkOfBody[i] : nullptr;
+                if (chunk && chunk->state == ChunkState::Frozen) {
+                    indexOfId[objects[i].id] = NoIndex;
+                    chunk->bodies.push_back(std::move(objects[i]));
+                } else {
+                    if (kept != i) objects[kept] = std::move(objects[i]);
+                    indexOfId[objects[kept].id] = static_cast<std::uint32_t>(kept);
+                    ++kept;
+                }
+            }
+            objects.erase(objects.begin() + static_cast<std::ptrdiff_t>(kept), objects.end());
+            chunkOfBody.clear();
+            solver.contacts.clear();        // their indices refer to the old layout
+
+            std::erase_if(awake, [](const Chunk* chunk) { return chunk->state != ChunkState::Awake; });
+            std::erase_if(chunks, [](const auto& entry) {
+                return entry.second.state == ChunkState::Frozen && entry.second.bodies.empty();
+            });
+            accelerationsValid = false;
+        }
+
+        // Pages out the longest frozen chunks beyond maxResidentChunks
+        void PageOut() {
+            frozenChunks.clear();
+            for (auto& [key, chunk] : chunks) {
+                if (chunk.state == ChunkState::Frozen) frozenChunks.push_back(&chunk);
+            }
+            if (frozenChunks.size() <= maxResidentChunks) return;
+
+            const std::size_t excess = frozenChunks.size() - maxResidentChunks;
+            std::nth_element(frozenChunks.begin(), frozenChunks.begin() + static_cast<std::ptrdiff_t>(excess - 1),
+                             frozenChunks.end(), [](const Chunk* a, const Chunk* b) { return a->frozenAt < b->frozenAt; });
+            for (std::size_t i = 0; i < excess; i++) {
+                if (!PageOutChunk(*frozenChunks[i])) break;
+            }
+        }
+    };
+
+}
+
+#endif //CHUNKEDWORLD_H
@@ -0,0 +1,203 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <variant>
+
+#include "World.h"
+
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    // **************************************** SPSC RING **************************************** //
+
+    // Bounded single-producer single-consumer queue. Each side owns one index and keeps a cached copy of
+    // the other's, so in the common case a push or pop touches no shared cache line at all.
+    // Neither side ever waits: a full ring refuses the push, an empty one the pop.
+    template<typename E>
+    class SpscRing {
+    public:
+        // Capacity is rounded up to a power of two
+        explicit SpscRing(std::size_t capacity) {
+            std::size_t size = 2;
+            while (size < capacity) size <<= 1;
+            buffer = std::make_unique<E[]>(size);
+            mask = size - 1;
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        [[nodiscard]] std::size_t Capacity() const noexcept { return mask + 1; }
+
+        // Producer side
+        bool TryPush(const E& value) noexcept {
+            const std::size_t h = head.load(std::memory_order_relaxed);
+            if (h - cachedTail > mask) {
+                cachedTail = tail.load(std::memory_order_acquire);
+                if (h - cachedTail > mask) return false;
+            }
+            buffer[h & mask] = value;
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side
+        bool TryPop(E& value) noexcept {
+            const std::size_t t = tail.load(std::memory_order_relaxed);
+            if (t == cachedHead) {
+                cachedHead = head.load(std::memory_order_acquire);
+                if (t == cachedHead) return false;
+            }
+            value = buffer[t & mask];
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::unique_ptr<E[]> buffer;
+        std::size_t mask = 0;
+
+        alignas(64) std::atomic<std::size_t> head{0};   // written by the producer
+        std::size_t cachedTail = 0;
+        alignas(64) std::atomic<std::size_t> tail{0};   // written by the consumer
+        std::size_t cachedHead = 0;
+    };
+
+
+    // ***************************************** COMMANDS ***************************************** //
+
+    // What the input side may ask of the simulation. Commands are plain values, so queueing one never
+    // allocates; they are applied by the physics thread between steps.
+    namespace Commands {
+        template<typename T>
+        struct SpawnBody {
+            char type;                  // 'c' or 'b', as BaseShape::getType()
+            Vector2<T> position;        // centre
+            T width, height;            // circle: width = radius
+            T mass;
+            Vector2<T> velocity;
+        };
+
+        // Impulse on every body under a point
+        template<typename T>
+        struct ApplyImpulse {
+            Vector2<T> point;
+            Vector2<T> impulse;         // N s
+        };
+
+        template<typename T>
+        struct AddWall {
+            Vector2<T> a, b;
+            T thickness;
+        };
+
+        struct SetPaused {
+            bool paused;
+        };
+
+        struct SetTimestep {
+            std::uint64_t milliseconds;
+        };
+
+        struct Resize {
+            std::uint32_t width, height;
+        };
+
+        // Moves through the rewind buffer, negative is back in time; pauses the simulation
+        struct Scrub {
+            std::int64_t ticks;
+        };
+    }
+
+    template<typename T>
+    using Command = std::variant<Commands::SpawnBody<T>, Commands::ApplyImpulse<T>, Commands::AddWall<T>,
+                                 Commands::SetPaused, Commands::SetTimestep, Commands::Resize, Commands::Scrub>;
+
+    template<typename T>
+    using CommandQueue = SpscRing<Command<T>>;
+
+    // State the commands drive that is not part of the world itself
+    struct SimulationControl {
+        bool paused = false;
+        std::int64_t scrub = 0;         // ticks still to move through the rewind buffer; the owner of the buffer clears it
+    };
+
+    // Whether the point lies on the body; boxes are centred on the object position
+    template<typename T>
+    [[nodiscard]] bool Touches(const Object<T>& obj, const Vector2<T>& point) {
+        const char type = obj.shape->getType();
+        if (type == 'c') {
+            const T r = dynamic_cast<Shape::Circle<T>*>(obj.shape)->radius;
+            const Vector2<T> d = point - obj.Vector2Position();
+            return d.dot(d) <= r * r;
+        }
+        if (type == 'b') {
+            const auto* box = dynamic_cast<Shape::Box<T>*>(obj.shape);
+            using std::abs;
+            return abs(point.x - obj.x) <= box->width / 2 && abs(point.y - obj.y) <= box->height / 2;
+        }
+        return false;
+    }
+
+    template<typename T, typename IntegratorPolicy, typename Forces>
+    void ApplyCommand(World<T, IntegratorPolicy, Forces>& world, SimulationControl& control, const Command<T>& command) {
+        std::visit([&](const auto& c) {
+            using C = std::decay_t<decltype(c)>;
+            if constexpr (std::is_same_v<C, Commands::SpawnBody<T>>) {
+                if (c.type == 'c') {
+                    Shape::Circle<T> circle{c.position.x, c.position.y, c.width};
+                    world.AddBody(Object<T>{c.position.x, c.position.y, c.mass, &circle, c.velocity.x, c.velocity.y});
+                } else if (c.type == 'b') {
+                    Shape::Box<T> box{c.position.x, c.position.y, c.width, c.height};
+                    world.AddBody(Object<T>{c.position.x, c.position.y, c.mass, &box, c.velocity.x, c.velocity.y});
+                }
+            } else if constexpr (std::is_same_v<C, Commands::ApplyImpulse<T>>) {
+                for (auto& obj : world.objects) {
+                    if (obj.mass <= 0 || !Touches(obj, c.point)) continue;
+                    obj.velocity += c.impulse / obj.mass;
+                }
+            } else if constexpr (std::is_same_v<C, Commands::AddWall<T>>) {
+                world.walls.AddSegment(c.a, c.b, c.thickness);
+            } else if constexpr (std::is_same_v<C, Commands::SetPaused>) {
+                control.paused = c.paused;
+            } else if constexpr (std::is_same_v<C, Commands::SetTimestep>) {
+                world.tickInterval = std::max<std::uint64_t>(c.milliseconds, 1);
+            } else if constexpr (std::is_same_v<C, Commands::Resize>) {
+                world.Resize(static_cast<T>(c.width), static_cast<T>(c.height));
+            } else if constexpr (std::is_same_v<C, Commands::Scrub>) {
+                control.paused = true;
+                control.scrub += c.ticks;
+            }
+        }, command);
+    }
+
+    // Applies up to maxCommands queued commands, in order. Call it between steps; whatever is left stays
+    // queued for the next tick, so a burst of input is spread out instead of stalling one step.
+    // Returns the number applied.
+    template<typename T, typename IntegratorPolicy, typename Forces>
+    std::size_t ApplyCommands(World<T, IntegratorPolicy, Forces>& world, SimulationControl& control,
+                              CommandQueue<T>& queue, const std::size_t maxCommands = 1024) {
+        Command<T> command;
+        std::size_t applied = 0;
+        while (applied < maxCommands && queue.TryPop(command)) {
+            ApplyCommand(world, control, command);
+            applied++;
+        }
+        return applied;
+    }
+
+}
+
+#endif //COMMANDQUEUE_H
@@ -0,0 +1,154 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "PhysicEngine.h"
+
+#ifndef CONTACTEVENTS_H
+#define CONTACTEVENTS_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    // ************************************** EVENT RING ************************************** //
+
+    // Bounded multi-producer multi-consumer queue (Vyukov). Every cell carries a sequence number telling
+    // whose turn it is, so producers and consumers only contend on their own position counter and
+    // neither side ever waits: a full ring refuses the push, an empty one the pop.
+    template<typename E>
+    class EventRing {
+    public:
+        // Capacity is rounded up to a power of two
+        explicit EventRing(std::size_t capacity) {
+            std::size_t size = 2;
+            while (size < capacity) size <<= 1;
+            cells = std::make_unique<Cell[]>(size);
+            mask = size - 1;
+            for (std::size_t i = 0; i < size; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        EventRing(const EventRing&) = delete;
+        EventRing& operator=(const EventRing&) = delete;
+
+        [[nodiscard]] std::size_t Capacity() const noexcept { return mask + 1; }
+
+        bool TryPush(const E& value) noexcept {
+            std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells[position & mask];
+                const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    return false;       // full
+                } else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            cell->value = value;
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPop(E& value) noexcept {
+            std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells[position & mask];
+                const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+                if (difference == 0) {
+                    if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (difference < 0) {
+                    return false;       // empty
+                } else {
+                    position = dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            value = cell->value;
+            cell->sequence.store(position + mask + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            E value;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        std::size_t mask = 0;
+        alignas(64) std::atomic<std::size_t> enqueuePosition{0};
+        alignas(64) std::atomic<std::size_t> dequeuePosition{0};
+    };
+
+
+    // ************************************* CONTACT EVENTS ************************************* //
+
+    enum class ContactPhase : std::uint8_t { Begin, Persist, End };
+
+    template<typename T>
+    struct ContactEvent {
+        std::uint32_t a;                // body ids, lower first
+        std::uint32_t b;
+        ContactPhase phase;
+        std::uint64_t tick;             // step the contact was solved in; for End, the first step without it
+        Vector2<T> point;               // for End, where the bodies last touched
+        Vector2<T> normal;              // from a to b
+        T normalImpulse;                // accumulated over the step, N s; 0 for End
+        T tangentImpulse;
+    };
+
+    // Where the solver publishes contact events for other threads to drain. Publishing never blocks the
+    // step: when consumers fall behind the ring fills up and further events are counted as dropped.
+    // Several worlds stepped on different threads may share one stream.
+    template<typename T>
+    class ContactEventStream {
+    public:
+        std::uint32_t groupMask = ~0u;  // only pairs with a body in one of these groups are reported
+
+        explicit ContactEventStream(const std::size_t capacity = 4096) : ring(capacity) {}
+
+        [[nodiscard]] bool Accepts(const Object<T>& a, const Object<T>& b) const noexcept {
+            return ((a.groups | b.groups) & groupMask) != 0;
+        }
+
+        void Publish(const ContactEvent<T>& event) noexcept {
+            if (!ring.TryPush(event)) dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool TryPop(ContactEvent<T>& event) noexcept { return ring.TryPop(event); }
+
+        // Pops up to maxEvents events into consume(event). Returns the number consumed.
+        template<typename Consume>
+        std::size_t Drain(Consume&& consume, const std::size_t maxEvents = std::numeric_limits<std::size_t>::max()) {
+            ContactEvent<T> event;
+            std::size_t n = 0;
+            while (n < maxEvents && ring.TryPop(event)) {
+                consume(event);
+                n++;
+            }
+            return n;
+        }
+
+        [[nodiscard]] std::uint64_t Dropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::size_t Capacity() const noexcept { return ring.Capacity(); }
+
+    private:
+        EventRing<ContactEvent<T>> ring;
+        std::atomic<std::uint64_t> dropped{0};
+    };
+
+}
+
+#endif //CONTACTEVENTS_H
@@ -0,0 +1,297 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "PhysicEngine.h"
+#include "ContactEvents.h"
+
+#ifndef CONTACTSOLVER_H
+#define CONTACTSOLVER_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    // ****************************************** CONTACT ****************************************** //
+
+    template<typename T>
+    struct Contact {
+        std::size_t a;              // index of the body with the lower id
+        std::size_t b;              // index of the body with the higher id
+        std::uint64_t key;          // PairKey(a.id, b.id)
+        Vector2<T> normal;          // unit normal, pointing from a to b
+        T penetration;
+
+        // Solver data, filled in by ContactSolver::Solve
+        T normalMass;
+        T tangentMass;
+        T bias;
+        T normalImpulse;            // accumulated over the iterations of one step
+        T tangentImpulse;
+    };
+
+    [[nodiscard]] constexpr std::uint64_t PairKey(const std::uint32_t id1, const std::uint32_t id2) noexcept {
+        const std::uint64_t lo = std::min(id1, id2);
+        const std::uint64_t hi = std::max(id1, id2);
+        return (hi << 32) | lo;
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr T InverseMass(const Object<T>& object) {
+        return object.mass > 0 ? 1 / object.mass : 0;
+    }
+
+    // Same geometry as CollisionProcess: boxes are centred on the object position.
+    // Returns false when the bodies are not penetrating.
+    template<typename T>
+    bool ComputeContact(const Object<T>& obj1, const Object<T>& obj2, Vector2<T>& normal, T& penetration) {
+        Vector2<T> vPosSub = obj2.Vector2Position() - obj1.Vector2Position();
+        T vDist = vPosSub.magnitude();
+        if (vDist == 0) {
+            vDist = T(1e-6);
+            vPosSub = Vector2<T>{0, T(1e-6)};
+        }
+        normal = vPosSub / vDist;
+        penetration = 0;
+
+        const char type1 = obj1.shape->getType();
+        const char type2 = obj2.shape->getType();
+
+        if (type1 == 'c' && type2 == 'c') {
+            auto* circle1 = dynamic_cast<Shape::Circle<T>*>(obj1.shape);
+            auto* circle2 = dynamic_cast<Shape::Circle<T>*>(obj2.shape);
+            penetration = (circle1->radius + circle2->radius) - vDist;
+        } else if ((type1 == 'c' && type2 == 'b') || (type1 == 'b' && type2 == 'c')) {
+            const bool circleFirst = type1 == 'c';
+            const Object<T>& circleObj = circleFirst ? obj1 : obj2;
+            const Object<T>& boxObj = circleFirst ? obj2 : obj1;
+            auto* circle = dynamic_cast<Shape::Circle<T>*>(circleObj.shape);
+            auto* box = dynamic_cast<Shape::Box<T>*>(boxObj.shape);
+
+            Vector2<T> closestPoint(
+                std::max(boxObj.x - box->width / 2, std::min(circleObj.x, boxObj.x + box->width / 2)),
+                std::max(boxObj.y - box->height / 2, std::min(circleObj.y, boxObj.y + box->height / 2))
+            );
+            Vector2<T> toCircle = circleObj.Vector2Position() - closestPoint;
+            const T distToBox = toCircle.magnitude();
+            if (distToBox > 0) {
+                // Normal from the closest point on the box, so flat faces push straight out
+                normal = circleFirst ? -(toCircle / distToBox) : toCircle / distToBox;
+            }
+            penetration = circle->radius - distToBox;
+        } else if (type1 == 'b' && type2 == 'b') {
+            auto* box1 = dynamic_cast<Shape::Box<T>*>(obj1.shape);
+            auto* box2 = dynamic_cast<Shape::Box<T>*>(obj2.shape);
+            T overlapX = std::min(obj1.x + box1->width / 2, obj2.x + box2->width / 2) -
+                         std::max(obj1.x - box1->width / 2, obj2.x - box2->width / 2);
+            T overlapY = std::min(obj1.y + box1->height / 2, obj2.y + box2->height / 2) -
+                         std::max(obj1.y - box1->height / 2, obj2.y - box2->height / 2);
+            // Separate along the axis of minimum overlap
+            if (overlapX < overlapY) {
+                normal = Vector2<T>{vPosSub.x < 0 ? T(-1) : T(1), 0};
+                penetration = overlapX;
+            } else {
+                normal = Vector2<T>{0, vPosSub.y < 0 ? T(-1) : T(1)};
+                penetration = overlapY;
+            }
+        }
+
+        return penetration > 0;
+    }
+
+
+    // *************************************** CONTACT SOLVER ************************************** //
+
+    // Sequential impulse solver with a persistent contact cache.
+    // Accumulated impulses are kept per body pair across steps and applied up front (warm start),
+    // so resting stacks converge in a few iterations instead of being rebuilt from zero every tick.
+    // The cache is a sorted array rebuilt from the contacts each step into a second buffer, so once both
+    // have grown to the largest contact count seen, solving allocates nothing.
+    template<typename T>
+    class ContactSolver {
+    public:
+        struct CachedImpulse {
+            std::uint64_t key;          // PairKey of the two bodies
+            T normalImpulse;
+            T tangentImpulse;
+            std::uint64_t lastStep;
+            Vector2<T> point;           // where the pair last touched, kept for its End event
+            bool reported;              // Begin was published, so End is too
+        };
+
+        int iterations;                 // velocity iterations per step
+        T restitution = 0.5;
+        T friction = 0.3;
+        T baumgarte = 0.2;              // fraction of penetration corrected per step
+        T penetrationSlop = 0.5;        // pixels of penetration left alone to keep contacts alive
+        T restitutionThreshold = 100;   // pixels per second (1 m/s), slower impacts do not bounce
+        T warmStartFactor = 1;
+
+        std::vector<Contact<T>> contacts{};
+        std::vector<CachedImpulse> cache{};    // pairs touching at the end of the last step, sorted by key
+        ContactEventStream<T>* events = nullptr;    // begin, persist and end of every contact, if set
+
+        explicit ContactSolver(const int iterations_ = 8) : iterations(iterations_) {}
+
+        // Room for this many simultaneous contacts
+        void Reserve(const std::size_t maxContacts) {
+            contacts.reserve(maxContacts);
+            cache.reserve(maxContacts);
+            nextCache.reserve(maxContacts);
+        }
+
+        // Forgets every contact and cached impulse, e.g. after the bodies were rewound: the next step starts
+        // cold and reports its contacts as new. No End events are published for the forgotten ones.
+        void Reset() {
+            contacts.clear();
+            cache.clear();
+            nextCache.clear();
+        }
+
+        [[nodiscard]] const CachedImpulse* FindCached(const std::uint64_t key) const noexcept {
+            const auto it = std::lower_bound(cache.begin(), cache.end(), key,
+                                             [](const CachedImpulse& c, const std::uint64_t k) { return c.key < k; });
+            return it != cache.end() && it->key == key ? &*it : nullptr;
+        }
+
+        void BeginStep() {
+            contacts.clear();
+            ++step;
+        }
+
+        // Narrow phase for one candidate pair. Returns true if a contact was recorded.
+        bool AddContact(const std::vector<Object<T>>& objects, std::size_t i, std::size_t j) {
+            if (objects[j].id < objects[i].id) std::swap(i, j);
+
+            Vector2<T> normal;
+            T penetration;
+            if (!ComputeContact(objects[i], objects[j], normal, penetration)) return false;
+
+            contacts.push_back(Contact<T>{i, j, PairKey(objects[i].id, objects[j].id), normal, penetration,
+                                          0, 0, 0, 0, 0});
+            return true;
+        }
+
+        // tick only stamps the contact events
+        void Solve(std::vector<Object<T>>& objects, T TickPassed, const std::uint64_t tick = 0) {
+            const T dt = TickPassed / 1000;     // 1 tick = 1 ms
+
+            PreStep(objects, dt);
+            for (int it = 0; it < iterations; it++) {
+                for (auto& c : contacts) SolveContact(objects, c);
+            }
+            StoreImpulses(objects, tick);
+        }
+
+    private:
+        std::uint64_t step = 0;
+        std::vector<CachedImpulse> nextCache{};
+
+        void ApplyImpulse(Object<T>& a, Object<T>& b, const Vector2<T>& impulse) {
+            a.velocity -= impulse * InverseMass(a);
+            b.velocity += impulse * InverseMass(b);
+        }
+
+        void PreStep(std::vector<Object<T>>& objects, const T dt) {
+            for (auto& c : contacts) {
+                Object<T>& a = objects[c.a];
+                Object<T>& b = objects[c.b];
+
+                const T invMassSum = InverseMass(a) + InverseMass(b);
+                c.normalMass = invMassSum > 0 ? 1 / invMassSum : 0;
+                c.tangentMass = c.normalMass;
+
+                // Bounce target from the approach speed, plus Baumgarte push-out for the penetration
+                const T vn = (b.velocity - a.velocity).dot(c.normal);
+                c.bias = vn < -restitutionThreshold ? -restitution * vn : 0;
+                if (dt > 0) c.bias += baumgarte / dt * std::max(c.penetration - penetrationSlop, T(0));
+
+                // Warm start from the impulses this pair ended the previous step with
+                if (const CachedImpulse* cached = FindCached(c.key); cached && cached->lastStep + 1 == step) {
+                    c.normalImpulse = cached->normalImpulse * warmStartFactor;
+                    c.tangentImpulse = cached->tangentImpulse * warmStartFactor;
+                    const Vector2<T> tangent{-c.normal.y, c.normal.x};
+                    ApplyImpulse(a, b, c.normal * c.normalImpulse + tangent * c.tangentImpulse);
+                }
+            }
+        }
+
+        void SolveContact(std::vector<Object<T>>& objects, Contact<T>& c) {
+            Object<T>& a = objects[c.a];
+            Object<T>& b = objects[c.b];
+            const Vector2<T> tangent{-c.normal.y, c.normal.x};
+
+            // Normal impulse, clamped so the accumulated impulse never pulls bodies together
+            T vn = (b.velocity - a.velocity).dot(c.normal);
+            T lambda = -c.normalMass * (vn - c.bias);
+            const T oldNormal = c.normalImpulse;
+            c.normalImpulse = std::max(oldNormal + lambda, T(0));
+            ApplyImpulse(a, b, c.normal * (c.normalImpulse - oldNormal));
+
+            // Coulomb friction, bounded by the current normal impulse
+            const T vt = (b.velocity - a.velocity).dot(tangent);
+            lambda = -c.tangentMass * vt;
+            const T maxFriction = friction * c.normalImpulse;
+            const T oldTangent = c.tangentImpulse;
+            c.tangentImpulse = std::clamp(oldTangent + lambda, -maxFriction, maxFriction);
+            ApplyImpulse(a, b, tangent * (c.tangentImpulse - oldTangent));
+        }
+
+        // Midway between the deepest points of the two bodies along the normal
+        static Vector2<T> ContactPoint(const Object<T>& a, const Object<T>& b, const Vector2<T>& normal) {
+            auto extent = [&normal](const Object<T>& o) -> T {
+                if (o.shape->getType() == 'c') return dynamic_cast<Shape::Circle<T>*>(o.shape)->radius;
+                const auto* box = dynamic_cast<Shape::Box<T>*>(o.shape);
+                using std::abs;
+                return abs(normal.x) * box->width / 2 + abs(normal.y) * box->height / 2;
+            };
+            return (a.Vector2Position() + normal * extent(a) + b.Vector2Position() - normal * extent(b)) / T(2);
+        }
+
+        // The cache tells new contacts from ones carried over, and which pairs it loses separated this step
+        void StoreImpulses(const std::vector<Object<T>>& objects, const std::uint64_t tick) {
+            nextCache.clear();
+            for (const auto& c : contacts) {
+                const CachedImpulse* cached = FindCached(c.key);
+                // A pair that was filtered out until now begins for the consumers
+                const bool persists = cached && cached->lastStep + 1 == step && cached->reported;
+                bool reported = false;
+                Vector2<T> point{};
+                if (events && events->Accepts(objects[c.a], objects[c.b])) {
+                    reported = true;
+                    point = ContactPoint(objects[c.a], objects[c.b], c.normal);
+                    // Ids from the key, lower first as End has them, whatever order the bodies are stored in
+                    const Vector2<T> normal = objects[c.a].id < objects[c.b].id ? c.normal : -c.normal;
+                    events->Publish(ContactEvent<T>{static_cast<std::uint32_t>(c.key),
+                                                    static_cast<std::uint32_t>(c.key >> 32),
+                                                    persists ? ContactPhase::Persist : ContactPhase::Begin, tick,
+                                                    point, normal, c.normalImpulse, c.tangentImpulse});
+                }
+                nextCache.push_back(CachedImpulse{c.key, c.normalImpulse, c.tangentImpulse, step, point, reported});
+            }
+            std::sort(nextCache.begin(), nextCache.end(),
+                      [](const CachedImpulse& x, const CachedImpulse& y) { return x.key < y.key; });
+
+            // Pairs only in the old cache separated this step
+            if (events) {
+                auto next = nextCache.begin();
+                for (const CachedImpulse& old : cache) {
+                    while (next != nextCache.end() && next->key < old.key) ++next;
+                    if ((next != nextCache.end() && next->key == old.key) || !old.reported) continue;
+                    events->Publish(ContactEvent<T>{static_cast<std::uint32_t>(old.key),
+                                                    static_cast<std::uint32_t>(old.key >> 32), ContactPhase::End,
+                                                    tick, old.point, Vector2<T>{}, T(0), T(0)});
+                }
+            }
+            cache.swap(nextCache);
+        }
+    };
+
+}
+
+#endif //CONTACTSOLVER_H
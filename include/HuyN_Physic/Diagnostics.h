@@ -0,0 +1,165 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "PhysicEngine.h"
+#include "ContactSolver.h"
+#include "ThreadPool.h"
+
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    template<typename T>
+    struct Diagnostics {
+        std::uint64_t tick{};
+        T kineticEnergy{};
+        T potentialEnergy{};            // uniform field, plus pairwise gravity if enabled
+        Vector2<T> momentum{};
+        T angularMomentum{};            // about the origin
+        T maxPenetration{};             // deepest contact of the last solve
+        T maxSpeed{};
+
+        [[nodiscard]] T totalEnergy() const { return kineticEnergy + potentialEnergy; }
+    };
+
+
+    // ************************************ DIAGNOSTICS COLLECTOR ************************************ //
+
+    // Conservation quantities computed as chunked reductions over the body array.
+    // Chunks are reduced in parallel when a pool is attached and always combined in chunk order,
+    // so results do not depend on the thread count. When disabled, the cost is one branch per tick.
+    template<typename T>
+    class DiagnosticsCollector {
+    public:
+        static constexpr std::size_t ChunkSize = 4096;
+        static constexpr std::size_t PairRowsPerChunk = 64;     // rows of the pair triangle per task
+
+        bool enabled = false;
+        bool pairwisePotential = false; // -G m1 m2 / r over all pairs: O(n^2), off by default
+        // px, as PairwiseGravity::cutoff, which World copies in. Pairs beyond it do not pull on each other,
+        // so they add nothing, and closer pairs are shifted by +G m1 m2 / cutoff to keep the sum conserved.
+        T pairwiseCutoff = 0;
+        ThreadPool* pool = nullptr;
+
+        Diagnostics<T> last{};
+
+        void Collect(const std::vector<Object<T>>& objects, const std::vector<Contact<T>>& contacts,
+                     const Vector2<T>& gravity, const std::uint64_t tick) {
+            const std::size_t chunks = (objects.size() + ChunkSize - 1) / ChunkSize;
+            partials.assign(chunks, Partial{});
+
+            auto reduceChunk = [&](const std::size_t chunk) {
+                Partial p{};
+                const std::size_t end = std::min(objects.size(), (chunk + 1) * ChunkSize);
+                for (std::size_t i = chunk * ChunkSize; i < end; i++) {
+                    const Object<T>& o = objects[i];
+                    const T speedSquared = o.velocity.dot(o.velocity);
+                    p.kinetic += o.mass * speedSquared;
+                    p.potential -= o.mass * (gravity.x * o.x + gravity.y * o.y);
+                    p.momentumX += o.mass * o.velocity.x;
+                    p.momentumY += o.mass * o.velocity.y;
+                    p.angular += o.mass * (o.x * o.velocity.y - o.y * o.velocity.x);
+                    p.maxSpeedSquared = std::max(p.maxSpeedSquared, speedSquared);
+                }
+                partials[chunk] = p;
+            };
+
+            if (pool) pool->ParallelFor(chunks, reduceChunk);
+            else for (std::size_t c = 0; c < chunks; c++) reduceChunk(c);
+
+            Partial total{};
+            for (const Partial& p : partials) {
+                total.kinetic += p.kinetic;
+                total.potential += p.potential;
+                total.momentumX += p.momentumX;
+                total.momentumY += p.momentumY;
+                total.angular += p.angular;
+                total.maxSpeedSquared = std::max(total.maxSpeedSquared, p.maxSpeedSquared);
+            }
+
+            T maxPenetration = 0;
+            for (const auto& c : contacts) maxPenetration = std::max(maxPenetration, c.penetration);
+
+            if (pairwisePotential) total.potential += PairPotential(objects);
+
+            last.tick = tick;
+            last.kineticEnergy = total.kinetic / 2;
+            last.potentialEnergy = total.potential;
+            last.momentum = Vector2<T>{total.momentumX, total.momentumY};
+            last.angularMomentum = total.angular;
+            last.maxPenetration = maxPenetration;
+            using std::sqrt;
+            last.maxSpeed = sqrt(total.maxSpeedSquared);
+        }
+
+    private:
+        struct Partial {
+            T kinetic{}, potential{}, momentumX{}, momentumY{}, angular{}, maxSpeedSquared{};
+        };
+        std::vector<Partial> partials;
+        std::vector<T> pairPartials;
+
+        // Each pair counted once, by its lower index. Rows are split into small chunks, since the triangle
+        // leaves the first rows with most of the work, and summed in chunk order like the body partials.
+        T PairPotential(const std::vector<Object<T>>& objects) {
+            const std::size_t chunks = (objects.size() + PairRowsPerChunk - 1) / PairRowsPerChunk;
+            pairPartials.assign(chunks, T{});
+            const T G = static_cast<T>(Gravitational_Constant);
+            const T cutoffSquared = pairwiseCutoff * pairwiseCutoff;
+            const T shift = pairwiseCutoff > 0 ? 1 / pairwiseCutoff : T{};
+
+            auto reduceRows = [&](const std::size_t chunk) {
+                T sum = 0;
+                const std::size_t end = std::min(objects.size(), (chunk + 1) * PairRowsPerChunk);
+                for (std::size_t i = chunk * PairRowsPerChunk; i < end; i++) {
+                    T row = 0;
+                    for (std::size_t j = i + 1; j < objects.size(); j++) {
+                        const Vector2<T> d = objects[j].Vector2Position() - objects[i].Vector2Position();
+                        const T distanceSquared = d.dot(d);
+                        if (pairwiseCutoff > 0 && distanceSquared > cutoffSquared) continue;
+                        using std::sqrt;
+                        const T distance = std::max(sqrt(distanceSquared), T(1e-6));
+                        row -= objects[j].mass * (1 / distance - shift);
+                    }
+                    sum += G * objects[i].mass * row;
+                }
+                pairPartials[chunk] = sum;
+            };
+
+            if (pool) pool->ParallelFor(chunks, reduceRows);
+            else for (std::size_t c = 0; c < chunks; c++) reduceRows(c);
+
+            T total = 0;
+            for (const T p : pairPartials) total += p;
+            return total;
+        }
+    };
+
+
+    // ************************************** CSV WRITER ************************************** //
+
+    inline void WriteDiagnosticsHeader(std::ostream& out) {
+        out << "tick,kinetic,potential,total,momentum_x,momentum_y,angular_momentum,max_penetration,max_speed\n";
+    }
+
+    template<typename T>
+    void WriteDiagnosticsRow(std::ostream& out, const Diagnostics<T>& d) {
+        out << d.tick << ',' << d.kineticEnergy << ',' << d.potentialEnergy << ',' << d.totalEnergy() << ','
+            << d.momentum.x << ',' << d.momentum.y << ',' << d.angularMomentum << ','
+            << d.maxPenetration << ',' << d.maxSpeed << '\n';
+    }
+
+}
+
+#endif //DIAGNOSTICS_H
@@ -0,0 +1,198 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+namespace HuyNPhysic {
+
+    // Q32.32 fixed-point scalar: 32 integer bits (about +-2.1e9) and 32 fraction bits (resolution 2.3e-10).
+    // Every operation is integer arithmetic, so the same inputs give bit-identical results on every machine,
+    // compiler and thread count. Products and quotients go through 128-bit intermediates.
+    // Overflow wraps (sums and differences are done on the unsigned representation, so it is defined);
+    // division by zero saturates instead of trapping.
+    // Conversions to and from floating point go through double with exact scaling by 2^32, never long double,
+    // whose width differs between targets.
+    class Fixed {
+    public:
+        static constexpr int FractionBits = 32;
+        static constexpr std::int64_t One = std::int64_t{1} << FractionBits;
+
+        std::int64_t raw = 0;
+
+        constexpr Fixed() noexcept = default;
+
+        template<std::integral I>
+        constexpr Fixed(const I value) noexcept : raw(Wrap(static_cast<std::uint64_t>(value) << FractionBits)) {}
+
+        // Rounds to the nearest representable value, halves away from zero; saturates out of range, NaN gives 0
+        template<std::floating_point F>
+        constexpr Fixed(const F value) noexcept : raw(FromDouble(static_cast<double>(value))) {}
+
+        [[nodiscard]] static constexpr Fixed FromRaw(const std::int64_t raw_) noexcept {
+            Fixed f;
+            f.raw = raw_;
+            return f;
+        }
+
+        // Truncates toward zero, like a floating-point cast
+        template<std::integral I>
+        [[nodiscard]] explicit constexpr operator I() const noexcept {
+            if (raw >= 0) return static_cast<I>(raw >> FractionBits);
+            return static_cast<I>(-static_cast<std::int64_t>((0 - static_cast<std::uint64_t>(raw)) >> FractionBits));
+        }
+
+        // Integer and fraction parts are each exact in double, so only the final sum rounds
+        template<std::floating_point F>
+        [[nodiscard]] explicit constexpr operator F() const noexcept {
+            const auto whole = static_cast<double>(raw >> FractionBits);
+            const auto fraction = static_cast<double>(static_cast<std::uint64_t>(raw) & (One - 1)) / Scale;
+            return static_cast<F>(whole + fraction);
+        }
+
+        // ************************************* ARITHMETIC ************************************* //
+
+        constexpr Fixed operator-() const noexcept { return FromRaw(Wrap(0 - static_cast<std::uint64_t>(raw))); }
+        constexpr Fixed operator+() const noexcept { return *this; }
+
+        constexpr Fixed& operator+=(const Fixed rhs) noexcept {
+            raw = Wrap(static_cast<std::uint64_t>(raw) + static_cast<std::uint64_t>(rhs.raw));
+            return *this;
+        }
+        constexpr Fixed& operator-=(const Fixed rhs) noexcept {
+            raw = Wrap(static_cast<std::uint64_t>(raw) - static_cast<std::uint64_t>(rhs.raw));
+            return *this;
+        }
+
+        // The 128-bit intermediates below cannot overflow; narrowing them back to 64 bits wraps
+
+        constexpr Fixed& operator*=(const Fixed rhs) noexcept {
+            raw = static_cast<std::int64_t>(static_cast<__int128>(raw) * rhs.raw >> FractionBits);
+            return *this;
+        }
+
+        constexpr Fixed& operator/=(const Fixed rhs) noexcept {
+            if (rhs.raw == 0) {
+                raw = raw < 0 ? std::numeric_limits<std::int64_t>::min() : std::numeric_limits<std::int64_t>::max();
+                return *this;
+            }
+            raw = static_cast<std::int64_t>((static_cast<__int128>(raw) << FractionBits) / rhs.raw);
+            return *this;
+        }
+
+        friend constexpr Fixed operator+(Fixed lhs, const Fixed rhs) noexcept { return lhs += rhs; }
+        friend constexpr Fixed operator-(Fixed lhs, const Fixed rhs) noexcept { return lhs -= rhs; }
+        friend constexpr Fixed operator*(Fixed lhs, const Fixed rhs) noexcept { return lhs *= rhs; }
+        friend constexpr Fixed operator/(Fixed lhs, const Fixed rhs) noexcept { return lhs /= rhs; }
+
+        friend constexpr bool operator==(Fixed lhs, Fixed rhs) noexcept = default;
+        friend constexpr std::strong_ordering operator<=>(const Fixed lhs, const Fixed rhs) noexcept {
+            return lhs.raw <=> rhs.raw;
+        }
+
+        friend std::ostream& operator<<(std::ostream& out, const Fixed value) {
+            return out << static_cast<double>(value);
+        }
+
+    private:
+        static constexpr double Scale = 4294967296.0;   // 2^FractionBits
+
+        // Two's complement reinterpretation; well defined since C++20
+        [[nodiscard]] static constexpr std::int64_t Wrap(const std::uint64_t bits) noexcept {
+            return static_cast<std::int64_t>(bits);
+        }
+
+        // Scaling by 2^32 is exact and |scaled| < 2^63 splits exactly into whole and fraction,
+        // so rounding needs no wider type
+        [[nodiscard]] static constexpr std::int64_t FromDouble(const double value) noexcept {
+            const double scaled = value * Scale;
+            if (scaled != scaled) return 0;
+            if (scaled >= 9223372036854775808.0) return std::numeric_limits<std::int64_t>::max();
+            if (scaled <= -9223372036854775808.0) return std::numeric_limits<std::int64_t>::min();
+            const auto whole = static_cast<std::int64_t>(scaled);     // toward zero
+            const double fraction = scaled - static_cast<double>(whole);
+            if (fraction >= 0.5) return whole + 1;
+            if (fraction <= -0.5) return whole - 1;
+            return whole;
+        }
+    };
+
+
+    // *************************************** MATH *************************************** //
+
+    // Found by argument-dependent lookup: engine code calls `using std::sqrt; sqrt(x)`, which picks these for Fixed.
+
+    inline constexpr Fixed FixedPi = Fixed::FromRaw(13493037705);      // round(pi * 2^32)
+
+    [[nodiscard]] constexpr Fixed abs(const Fixed x) noexcept { return x.raw < 0 ? -x : x; }
+
+    [[nodiscard]] constexpr Fixed floor(const Fixed x) noexcept { return Fixed::FromRaw(x.raw & ~(Fixed::One - 1)); }
+
+    [[nodiscard]] constexpr Fixed ceil(const Fixed x) noexcept { return -floor(-x); }
+
+    // Exact floor of the square root of the raw value shifted by 32. The double estimate only seeds the search,
+    // the integer correction makes the result independent of the platform's floating point.
+    [[nodiscard]] inline Fixed sqrt(const Fixed x) noexcept {
+        if (x.raw <= 0) return Fixed{};
+        const unsigned __int128 n = static_cast<unsigned __int128>(x.raw) << Fixed::FractionBits;
+        auto r = static_cast<unsigned __int128>(std::sqrt(static_cast<double>(n)));
+        while (r * r > n) r--;
+        while ((r + 1) * (r + 1) <= n) r++;
+        return Fixed::FromRaw(static_cast<std::int64_t>(r));
+    }
+
+    // Taylor series to x^13 after reducing to [-pi/2, pi/2]; error stays below 1e-9
+    [[nodiscard]] constexpr Fixed sin(Fixed x) noexcept {
+        const Fixed twoPi = FixedPi * 2, halfPi = FixedPi / 2;
+        x -= twoPi * floor((x + FixedPi) / twoPi);
+        if (x > halfPi) x = FixedPi - x;
+        else if (x < -halfPi) x = -FixedPi - x;
+
+        const Fixed x2 = x * x;
+        Fixed series = 1;
+        for (const int k : {156, 110, 72, 42, 20, 6}) series = 1 - x2 / k * series;
+        return x * series;
+    }
+
+    [[nodiscard]] constexpr Fixed cos(const Fixed x) noexcept { return sin(x + FixedPi / 2); }
+
+    // Bisection on cos over [0, pi]: slow, but exact to the last bit and only used for angle queries
+    [[nodiscard]] constexpr Fixed acos(Fixed x) noexcept {
+        if (x >= 1) return Fixed{};
+        if (x <= -1) return FixedPi;
+        Fixed lo = 0, hi = FixedPi;
+        while (hi.raw - lo.raw > 1) {
+            const Fixed mid = Fixed::FromRaw(lo.raw + (hi.raw - lo.raw) / 2);
+            if (cos(mid) > x) lo = mid;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+}
+
+template<>
+class std::numeric_limits<HuyNPhysic::Fixed> {
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = true;
+    static constexpr int digits = 63;
+
+    static constexpr HuyNPhysic::Fixed min() noexcept { return HuyNPhysic::Fixed::FromRaw(1); }
+    static constexpr HuyNPhysic::Fixed lowest() noexcept { return HuyNPhysic::Fixed::FromRaw(std::numeric_limits<std::int64_t>::min()); }
+    static constexpr HuyNPhysic::Fixed max() noexcept { return HuyNPhysic::Fixed::FromRaw(std::numeric_limits<std::int64_t>::max()); }
+    static constexpr HuyNPhysic::Fixed epsilon() noexcept { return HuyNPhysic::Fixed::FromRaw(1); }
+};
+
+#endif //FIXEDPOINT_H
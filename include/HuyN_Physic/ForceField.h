@@ -0,0 +1,325 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "PhysicEngine.h"
+
+#ifndef FORCEFIELD_H
+#define FORCEFIELD_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    // What kernels may read about the world they are evaluated in
+    template<typename T>
+    struct ForceContext {
+        Vector2<T> gravity;
+        T floor;                        // y of the floor line
+        T dt;                           // seconds per step
+        const std::vector<std::uint32_t>* indexOfId;    // id -> index into objects, for kernels that name bodies
+    };
+
+    constexpr std::uint32_t NoBodyIndex = ~0u;
+
+    template<typename T>
+    [[nodiscard]] bool OnFloor(const Object<T>& obj, const T floor) {
+        const char shapeType = obj.shape->getType();
+        if (shapeType == 'c') {
+            auto* circle = dynamic_cast<Shape::Circle<T>*>(obj.shape);
+            return obj.y + circle->radius >= floor;
+        }
+        if (shapeType == 'b') {
+            auto* box = dynamic_cast<Shape::Box<T>*>(obj.shape);
+            return obj.y + box->height / 2 >= floor;
+        }
+        return false;
+    }
+
+
+    // ************************************** BODY KERNELS ************************************** //
+
+    // A body kernel returns the acceleration it contributes to one body:
+    //
+    //     Vector2<T> Acceleration(const Object<T>& body, const ForceContext<T>& context) const
+    //
+    // All body kernels of a field are summed in a single sweep over the bodies.
+
+    struct UniformGravity {
+        template<typename T>
+        Vector2<T> Acceleration(const Object<T>&, const ForceContext<T>& context) const {
+            return context.gravity;
+        }
+    };
+
+    // Linear drag a = -k v, in the implicit form -k v / (1 + k dt): one kick gives v / (1 + k dt),
+    // so large coefficients stay stable
+    template<typename T>
+    struct LinearDrag {
+        T coefficient = 0;              // per second
+
+        Vector2<T> Acceleration(const Object<T>& body, const ForceContext<T>& context) const {
+            if (coefficient <= 0) return Vector2<T>{};
+            return body.velocity * (-coefficient / (1 + coefficient * context.dt));
+        }
+    };
+
+    // Kinetic friction against the floor, with the uniform field as normal load.
+    // Slows horizontal motion and stops it within the step, but never reverses it.
+    // Forces are evaluated mid-step, while resting bodies hover a hair above the floor after their boundary
+    // bounce, so bodies within contactMargin of the floor count as touching it.
+    template<typename T>
+    struct FloorFriction {
+        T coefficient = T(0.3);
+        T contactMargin = 1;            // px
+
+        Vector2<T> Acceleration(const Object<T>& body, const ForceContext<T>& context) const {
+            if (coefficient <= 0 || context.gravity.y <= 0 || !OnFloor(body, context.floor - contactMargin)) return Vector2<T>{};
+            const T deceleration = coefficient * context.gravity.y;
+            using std::abs;
+            if (context.dt > 0 && abs(body.velocity.x) <= deceleration * context.dt) {
+                return Vector2<T>{-body.velocity.x / context.dt, T(0)};
+            }
+            return Vector2<T>{body.velocity.x > 0 ? -deceleration : deceleration, T(0)};
+        }
+    };
+
+    // Any callable field(body) -> acceleration, e.g. wind, attractors or a vortex
+    template<typename Field>
+    struct UserField {
+        Field field;
+
+        template<typename T>
+        Vector2<T> Acceleration(const Object<T>& body, const ForceContext<T>&) const {
+            return field(body);
+        }
+    };
+
+    template<typename Field>
+    UserField<std::decay_t<Field>> MakeUserField(Field&& field) {
+        return UserField<std::decay_t<Field>>{std::forward<Field>(field)};
+    }
+
+
+    // ************************************** PAIR KERNELS ************************************** //
+
+    // A pair kernel adds to the accelerations the body sweep wrote:
+    //
+    //     void Accumulate(std::vector<Object<T>>& bodies, const ForceContext<T>& context) const
+    //
+    // and may also offer the same for a subset of bodies, for integrators that only update some of them:
+    //
+    //     void AccumulateActive(std::vector<Object<T>>& bodies, const std::vector<std::uint32_t>& active,
+    //                           const ForceContext<T>& context) const
+
+    // Newtonian attraction between every pair closer than the cutoff.
+    // Floating point only: in Q32.32 G = 6.674e-11 rounds to 0 and 1 / r^3 saturates below r = 6e-4, so a
+    // fixed build would silently simulate no gravity, or huge kicks between nearly coincident bodies.
+    template<typename T>
+    struct PairwiseGravity {
+        static_assert(!std::numeric_limits<T>::is_exact, "PairwiseGravity needs a floating-point scalar");
+
+        T cutoff = 0;                   // px; 0 means no cutoff
+
+        void Accumulate(std::vector<Object<T>>& bodies, const ForceContext<T>&) const {
+            const T G = static_cast<T>(Gravitational_Constant);
+            const T cutoffSquared = cutoff * cutoff;
+            for (std::size_t i = 0; i + 1 < bodies.size(); i++) {
+                Object<T>& a = bodies[i];
+                for (std::size_t j = i + 1; j < bodies.size(); j++) {
+                    Object<T>& b = bodies[j];
+                    const Vector2<T> d = b.Vector2Position() - a.Vector2Position();
+                    const T distanceSquared = d.dot(d);
+                    if (cutoff > 0 && distanceSquared > cutoffSquared) continue;
+
+                    // G / r^2 along the unit direction d / r
+                    const Vector2<T> pull = d * (G * InverseDistanceCubed(distanceSquared));
+                    a.acceleration += pull * b.mass;
+                    b.acceleration -= pull * a.mass;
+                }
+            }
+        }
+
+        // Pull of every body on the active ones only: O(active * n) instead of O(n^2)
+        void AccumulateActive(std::vector<Object<T>>& bodies, const std::vector<std::uint32_t>& active,
+                              const ForceContext<T>&) const {
+            const T G = static_cast<T>(Gravitational_Constant);
+            const T cutoffSquared = cutoff * cutoff;
+            for (const std::uint32_t i : active) {
+                Object<T>& a = bodies[i];
+                for (std::size_t j = 0; j < bodies.size(); j++) {
+                    if (j == i) continue;
+                    const Vector2<T> d = bodies[j].Vector2Position() - a.Vector2Position();
+                    const T distanceSquared = d.dot(d);
+                    if (cutoff > 0 && distanceSquared > cutoffSquared) continue;
+
+                    a.acceleration += d * (G * bodies[j].mass * InverseDistanceCubed(distanceSquared));
+                }
+            }
+        }
+
+    private:
+        // 1 / r^3 with r held at MinDistance, so coincident bodies do not blow up; MinDistance^3 = 1e-18 is
+        // still a normal float
+        static constexpr T MinDistance = T(1e-6);
+
+        [[nodiscard]] static T InverseDistanceCubed(const T distanceSquared) {
+            using std::sqrt;
+            const T distance = std::max(sqrt(distanceSquared), MinDistance);
+            return 1 / (distance * distance * distance);
+        }
+    };
+
+    // Damped springs between bodies named by id; springs whose bodies were removed are skipped
+    template<typename T>
+    struct Springs {
+        struct Spring {
+            std::uint32_t a, b;         // body ids
+            T restLength;
+            T stiffness;                // N per px
+            T damping;                  // N per px/s along the spring
+        };
+
+        std::vector<Spring> springs{};
+
+        void Accumulate(std::vector<Object<T>>& bodies, const ForceContext<T>& context) const {
+            if (springs.empty() || !context.indexOfId) return;
+            const auto& indexOfId = *context.indexOfId;
+            auto indexOf = [&](const std::uint32_t id) { return id < indexOfId.size() ? indexOfId[id] : NoBodyIndex; };
+
+            for (const Spring& s : springs) {
+                const std::uint32_t i = indexOf(s.a), j = indexOf(s.b);
+                if (i == NoBodyIndex || j == NoBodyIndex) continue;
+                Object<T>& a = bodies[i];
+                Object<T>& b = bodies[j];
+
+                const Vector2<T> d = b.Vector2Position() - a.Vector2Position();
+                const T length = d.magnitude();
+                if (length == 0) continue;
+                const Vector2<T> direction = d / length;
+                const T stretchSpeed = (b.velocity - a.velocity).dot(direction);
+                const Vector2<T> force = direction * (s.stiffness * (length - s.restLength) + s.damping * stretchSpeed);
+                if (a.mass > 0) a.acceleration += force / a.mass;
+                if (b.mass > 0) b.acceleration -= force / b.mass;
+            }
+        }
+    };
+
+
+    // *************************************** FORCE FIELD *************************************** //
+
+    template<typename K, typename T>
+    concept BodyKernel = requires(const K& k, const Object<T>& body, const ForceContext<T>& context) {
+        { k.Acceleration(body, context) } -> std::convertible_to<Vector2<T>>;
+    };
+
+    template<typename K, typename T>
+    concept PairKernel = requires(const K& k, std::vector<Object<T>>& bodies, const ForceContext<T>& context) {
+        k.Accumulate(bodies, context);
+    };
+
+    template<typename K, typename T>
+    concept ActivePairKernel = requires(const K& k, std::vector<Object<T>>& bodies,
+                                        const std::vector<std::uint32_t>& active, const ForceContext<T>& context) {
+        k.AccumulateActive(bodies, active, context);
+    };
+
+    // Kernels composed at compile time. Compute() overwrites every acceleration with the sum of the body
+    // kernels in one sweep, so nothing carries over from the previous evaluation, then lets the pair kernels
+    // add on top. Kernels are reached with Get<K>() to tune their parameters.
+    // Given a list of active body indices, only those accelerations are recomputed; pair kernels without
+    // AccumulateActive run in full and the other bodies' accelerations are put back afterwards.
+    template<typename T, typename... Kernels>
+    class ForceField {
+    public:
+        std::tuple<Kernels...> kernels{};
+
+        ForceField() = default;
+        explicit ForceField(Kernels... kernels_) : kernels(std::move(kernels_)...) {}
+
+        template<typename K>
+        [[nodiscard]] K& Get() noexcept { return std::get<K>(kernels); }
+        template<typename K>
+        [[nodiscard]] const K& Get() const noexcept { return std::get<K>(kernels); }
+
+        void Compute(std::vector<Object<T>>& bodies, const ForceContext<T>& context,
+                     const std::vector<std::uint32_t>* active = nullptr) const {
+            if (!active) {
+                for (auto& body : bodies) SumBodyKernels(body, context);
+                std::apply([&](const auto&... k) { (RunPairKernel(k, bodies, context), ...); }, kernels);
+                return;
+            }
+            for (const std::uint32_t i : *active) SumBodyKernels(bodies[i], context);
+            std::apply([&](const auto&... k) { (RunPairKernelActive(k, bodies, *active, context), ...); }, kernels);
+        }
+
+    private:
+        template<typename K>
+        static void AddBodyKernel(const K& k, const Object<T>& body, const ForceContext<T>& context,
+                                  Vector2<T>& acceleration) {
+            if constexpr (BodyKernel<K, T>) acceleration += k.Acceleration(body, context);
+        }
+
+        void SumBodyKernels(Object<T>& body, const ForceContext<T>& context) const {
+            Vector2<T> acceleration{};
+            std::apply([&](const auto&... k) { (AddBodyKernel(k, body, context, acceleration), ...); }, kernels);
+            body.acceleration = acceleration;
+        }
+
+        template<typename K>
+        static void RunPairKernel(const K& k, std::vector<Object<T>>& bodies, const ForceContext<T>& context) {
+            if constexpr (PairKernel<K, T>) k.Accumulate(bodies, context);
+        }
+
+        mutable std::vector<Vector2<T>> saved{};
+        mutable std::vector<std::uint8_t> isActive{};
+
+        template<typename K>
+        void RunPairKernelActive(const K& k, std::vector<Object<T>>& bodies, const std::vector<std::uint32_t>& active,
+                                 const ForceContext<T>& context) const {
+            if constexpr (ActivePairKernel<K, T>) {
+                k.AccumulateActive(bodies, active, context);
+            } else if constexpr (PairKernel<K, T>) {
+                saved.resize(bodies.size(), Vector2<T>{});
+                isActive.assign(bodies.size(), 0);
+                for (const std::uint32_t i : active) isActive[i] = 1;
+                for (std::size_t i = 0; i < bodies.size(); i++) saved[i] = bodies[i].acceleration;
+                k.Accumulate(bodies, context);
+                for (std::size_t i = 0; i < bodies.size(); i++) if (!isActive[i]) bodies[i].acceleration = saved[i];
+            }
+        }
+
+        static_assert(((BodyKernel<Kernels, T> || PairKernel<Kernels, T>) && ...),
+                      "every kernel needs Acceleration(body, context) or Accumulate(bodies, context)");
+    };
+
+    // Whether a force field type holds kernel K; false for anything that is not a ForceField
+    template<typename Forces, typename K>
+    inline constexpr bool HasKernel = false;
+
+    template<typename T, typename... Kernels, typename K>
+    inline constexpr bool HasKernel<ForceField<T, Kernels...>, K> = (std::is_same_v<Kernels, K> || ...);
+
+    // What World uses unless told otherwise: only per-body kernels, so computing forces is one O(n) sweep.
+    // Bodies attracting each other is opt-in, as O(n^2) PairwiseGravity or the mesh in ParticleMesh.h.
+    template<typename T>
+    using DefaultForceField = ForceField<T, UniformGravity, FloorFriction<T>, LinearDrag<T>>;
+
+    // The default forces plus direct pairwise gravity, for small floating-point scenes
+    template<typename T>
+    using PairwiseGravityForceField = ForceField<T, UniformGravity, FloorFriction<T>, LinearDrag<T>, PairwiseGravity<T>>;
+
+}
+
+#endif //FORCEFIELD_H
@@ -0,0 +1,249 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "PhysicEngine.h"
+
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic::Integrator {
+
+    // Integrators are picked as a template policy, so the stepping loop has no runtime switch.
+    // Every policy has the same shape:
+    //
+    //     Policy::Step(objects, TickPassed, computeAccelerations)
+    //
+    // computeAccelerations(objects) must overwrite every object's acceleration from the current positions
+    // (and velocities, for velocity dependent fields). Policies call it as many times as they need per step.
+    // computeAccelerations(objects, &active) does the same for the listed indices only.
+    // Contacts are applied by the caller after the step. World keeps one instance of the policy, so a policy
+    // may carry parameters and per-body state.
+
+    template<typename T>
+    constexpr T TickToSeconds(T TickPassed) {
+        return TickPassed / T(1000);   // 1 tick = 1 ms
+    }
+
+    template<typename T>
+    void Drift(std::vector<Object<T>>& objects, T dt) {
+        for (auto& o : objects) {
+            o.x += o.velocity.x * dt;
+            o.y += o.velocity.y * dt;
+        }
+    }
+
+    template<typename T>
+    void Kick(std::vector<Object<T>>& objects, T dt) {
+        for (auto& o : objects) o.velocity += o.acceleration * dt;
+    }
+
+    template<typename T>
+    void SyncShapes(std::vector<Object<T>>& objects) {
+        for (auto& o : objects) o.syncShapePosition();
+    }
+
+
+    // ************************************ SEMI-IMPLICIT EULER ************************************ //
+
+    // First order, symplectic. One force evaluation per step; this is what Object::PhysicStep does.
+    struct SemiImplicitEuler {
+        template<typename T, typename ComputeAccelerations>
+        static void Step(std::vector<Object<T>>& objects, T TickPassed, ComputeAccelerations&& computeAccelerations) {
+            const T dt = TickToSeconds(TickPassed);
+            computeAccelerations(objects);
+            Kick(objects, dt);
+            Drift(objects, dt);
+            SyncShapes(objects);
+        }
+    };
+
+
+    // ************************************** VELOCITY VERLET ************************************** //
+
+    // Second order, symplectic (kick-drift-kick). One force evaluation per step: the accelerations left
+    // in the objects by the previous step are reused for the first half kick.
+    struct VelocityVerlet {
+        template<typename T, typename ComputeAccelerations>
+        static void Step(std::vector<Object<T>>& objects, T TickPassed, ComputeAccelerations&& computeAccelerations) {
+            const T dt = TickToSeconds(TickPassed);
+            Kick(objects, dt / 2);
+            Drift(objects, dt);
+            computeAccelerations(objects);
+            Kick(objects, dt / 2);
+            SyncShapes(objects);
+        }
+    };
+
+
+    // ***************************************** LEAPFROG ****************************************** //
+
+    // Second order, symplectic (drift-kick-drift). Forces are evaluated at the half step position,
+    // so no acceleration has to survive between steps.
+    struct Leapfrog {
+        template<typename T, typename ComputeAccelerations>
+        static void Step(std::vector<Object<T>>& objects, T TickPassed, ComputeAccelerations&& computeAccelerations) {
+            const T dt = TickToSeconds(TickPassed);
+            Drift(objects, dt / 2);
+            computeAccelerations(objects);
+            Kick(objects, dt);
+            Drift(objects, dt / 2);
+            SyncShapes(objects);
+        }
+    };
+
+
+    // ******************************************* RK4 ******************************************* //
+
+    // Classic fourth order Runge-Kutta. Not symplectic and four force evaluations per step;
+    // kept as a reference to compare the other policies against.
+    struct RK4 {
+        template<typename T, typename ComputeAccelerations>
+        static void Step(std::vector<Object<T>>& objects, T TickPassed, ComputeAccelerations&& computeAccelerations) {
+            const T dt = TickToSeconds(TickPassed);
+            const std::size_t n = objects.size();
+
+            struct Derivative {
+                Vector2<T> dx;
+                Vector2<T> dv;
+            };
+            static thread_local std::vector<Vector2<T>> x0, v0;
+            static thread_local std::vector<Derivative> sum;
+            x0.resize(n);
+            v0.resize(n);
+            sum.assign(n, Derivative{Vector2<T>{}, Vector2<T>{}});
+
+            for (std::size_t i = 0; i < n; i++) {
+                x0[i] = objects[i].Vector2Position();
+                v0[i] = objects[i].velocity;
+            }
+
+            // k1 at the start, k2 and k3 at the midpoint, k4 at the end
+            constexpr T stageOffset[4] = {0, T(0.5), T(0.5), 1};
+            constexpr T stageWeight[4] = {1, 2, 2, 1};
+
+            for (int stage = 0; stage < 4; stage++) {
+                computeAccelerations(objects);
+                for (std::size_t i = 0; i < n; i++) {
+                    Object<T>& o = objects[i];
+                    const Vector2<T> kx = o.velocity;
+                    const Vector2<T> kv = o.acceleration;
+                    sum[i].dx += kx * stageWeight[stage];
+                    sum[i].dv += kv * stageWeight[stage];
+
+                    if (stage < 3) {
+                        const T h = dt * stageOffset[stage + 1];
+                        o.x = x0[i].x + kx.x * h;
+                        o.y = x0[i].y + kx.y * h;
+                        o.velocity = v0[i] + kv * h;
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < n; i++) {
+                Object<T>& o = objects[i];
+                o.x = x0[i].x + sum[i].dx.x * dt / 6;
+                o.y = x0[i].y + sum[i].dx.y * dt / 6;
+                o.velocity = v0[i] + sum[i].dv * (dt / 6);
+            }
+            SyncShapes(objects);
+        }
+    };
+
+
+
+    // ************************************** BLOCK TIMESTEP ************************************** //
+
+    // Velocity Verlet with individual power-of-two timesteps. A step of the caller is cut into 2^maxRung
+    // sub-ticks; a body on rung r advances in steps of 2^(maxRung - r) sub-ticks. All bodies drift every
+    // sub-tick, so positions stay synchronised, but only the bodies whose step ends at a sub-tick get their
+    // forces recomputed and their closing kick. A body's rung is chosen from its acceleration and speed:
+    //
+    //     dt = min(sqrt(2 * accuracy * softening / |a|), maxDisplacement / |v|)
+    //
+    // It may move to a faster rung at the end of any of its steps, and to a slower one only where the slower
+    // step boundary lines up with the current sub-tick. Rungs are kept by body id, so reordering storage is safe.
+    struct BlockTimestep {
+        int maxRung = 6;                // up to 64 sub-ticks per step
+        double accuracy = 0.025;
+        double softening = 1;           // px
+        double maxDisplacement = 5;     // px per timestep; 0 disables the velocity criterion
+
+        std::uint64_t forceEvaluations = 0;     // bodies whose forces were recomputed, for profiling
+
+        template<typename T, typename ComputeAccelerations>
+        void Step(std::vector<Object<T>>& objects, T TickPassed, ComputeAccelerations&& computeAccelerations) {
+            const T dt = TickToSeconds(TickPassed);
+            const std::uint64_t subTicks = std::uint64_t{1} << maxRung;
+            const T h = dt / static_cast<T>(subTicks);
+
+            // Bodies seen for the first time get a rung from the accelerations they came in with
+            for (const auto& o : objects) {
+                if (o.id >= rungs.size()) rungs.resize(o.id + 1, Unassigned);
+                if (rungs[o.id] == Unassigned) rungs[o.id] = static_cast<std::uint8_t>(ChooseRung(o, static_cast<double>(dt)));
+            }
+
+            for (std::uint64_t s = 0; s < subTicks; s++) {
+                // Opening half kick for bodies whose step starts here
+                for (auto& o : objects) {
+                    const std::uint64_t span = subTicks >> rungs[o.id];
+                    if (s % span == 0) o.velocity += o.acceleration * (h * static_cast<T>(span) / 2);
+                }
+                Drift(objects, h);
+
+                active.clear();
+                for (std::uint32_t i = 0; i < objects.size(); i++) {
+                    if ((s + 1) % (subTicks >> rungs[objects[i].id]) == 0) active.push_back(i);
+                }
+                if (active.empty()) continue;
+
+                if (active.size() == objects.size()) computeAccelerations(objects);
+                else computeAccelerations(objects, &active);
+                forceEvaluations += active.size();
+
+                // Closing half kick, then the rung for the next step
+                int slowestAligned = 0;
+                while (slowestAligned < maxRung && (s + 1) % (subTicks >> slowestAligned) != 0) slowestAligned++;
+                for (const std::uint32_t i : active) {
+                    Object<T>& o = objects[i];
+                    const std::uint64_t span = subTicks >> rungs[o.id];
+                    o.velocity += o.acceleration * (h * static_cast<T>(span) / 2);
+                    rungs[o.id] = static_cast<std::uint8_t>(std::max(ChooseRung(o, static_cast<double>(dt)), slowestAligned));
+                }
+            }
+            SyncShapes(objects);
+        }
+
+        [[nodiscard]] int RungOf(const std::uint32_t id) const noexcept {
+            return id < rungs.size() && rungs[id] != Unassigned ? rungs[id] : 0;
+        }
+
+    private:
+        static constexpr std::uint8_t Unassigned = 0xFF;
+        std::vector<std::uint8_t> rungs{};          // by body id
+        std::vector<std::uint32_t> active{};
+
+        template<typename T>
+        [[nodiscard]] int ChooseRung(const Object<T>& o, const double dt) const {
+            double step = dt;
+            const double a = static_cast<double>(o.acceleration.magnitude());
+            const double v = static_cast<double>(o.velocity.magnitude());
+            if (a > 0) step = std::min(step, std::sqrt(2 * accuracy * softening / a));
+            if (maxDisplacement > 0 && v > 0) step = std::min(step, maxDisplacement / v);
+            int rung = 0;
+            while (rung < maxRung && dt / static_cast<double>(std::uint64_t{1} << rung) > step) rung++;
+            return rung;
+        }
+    };
+
+}
+
+#endif //INTEGRATOR_H
@@ -0,0 +1,339 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include "PhysicEngine.h"
+#include "ForceField.h"
+#include "ThreadPool.h"
+
+#ifndef PARTICLEMESH_H
+#define PARTICLEMESH_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    namespace FFT {
+
+        using Complex = std::complex<double>;
+
+        // exp(-2 pi i k / n) for k < n / 2
+        inline std::vector<Complex> Twiddles(const std::size_t n) {
+            std::vector<Complex> twiddles(n / 2);
+            for (std::size_t k = 0; k < n / 2; k++) {
+                const double angle = -2 * M_PI * static_cast<double>(k) / static_cast<double>(n);
+                twiddles[k] = Complex{std::cos(angle), std::sin(angle)};
+            }
+            return twiddles;
+        }
+
+        // In-place iterative radix-2 transform of n contiguous values, n a power of two.
+        // The inverse is unscaled.
+        inline void Transform(Complex* data, const std::size_t n, const std::vector<Complex>& twiddles, const bool inverse) {
+            for (std::size_t i = 1, j = 0; i < n; i++) {
+                std::size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1) j ^= bit;
+                j ^= bit;
+                if (i < j) std::swap(data[i], data[j]);
+            }
+            for (std::size_t length = 2; length <= n; length <<= 1) {
+                const std::size_t half = length / 2, step = n / length;
+                for (std::size_t start = 0; start < n; start += length) {
+                    for (std::size_t k = 0; k < half; k++) {
+                        const Complex w = inverse ? std::conj(twiddles[k * step]) : twiddles[k * step];
+                        const Complex odd = data[start + k + half] * w;
+                        data[start + k + half] = data[start + k] - odd;
+                        data[start + k] += odd;
+                    }
+                }
+            }
+        }
+
+        // Row-major nx * ny grid: rows in place, columns through a per-thread contiguous copy.
+        // Rows and columns are independent, so both passes run on the pool.
+        inline void Transform2D(std::vector<Complex>& grid, const std::size_t nx, const std::size_t ny,
+                                const std::vector<Complex>& twiddlesX, const std::vector<Complex>& twiddlesY,
+                                const bool inverse, ThreadPool* pool) {
+            auto row = [&](const std::size_t y) { Transform(grid.data() + y * nx, nx, twiddlesX, inverse); };
+            auto column = [&](const std::size_t x) {
+                static thread_local std::vector<Complex> scratch;
+                scratch.resize(ny);
+                for (std::size_t y = 0; y < ny; y++) scratch[y] = grid[y * nx + x];
+                Transform(scratch.data(), ny, twiddlesY, inverse);
+                for (std::size_t y = 0; y < ny; y++) grid[y * nx + x] = scratch[y];
+            };
+            if (pool) {
+                pool->ParallelFor(ny, row);
+                pool->ParallelFor(nx, column);
+            } else {
+                for (std::size_t y = 0; y < ny; y++) row(y);
+                for (std::size_t x = 0; x < nx; x++) column(x);
+            }
+        }
+
+        [[nodiscard]] constexpr std::size_t NextPowerOfTwo(std::size_t n) noexcept {
+            std::size_t p = 1;
+            while (p < n) p <<= 1;
+            return p;
+        }
+
+    }
+
+
+    // ********************************** PARTICLE-MESH GRAVITY ********************************** //
+
+    // Pairwise gravity through a mesh, for large, dense scenes where O(n^2) pairs are out of reach.
+    //
+    //   1. Mass is deposited on a grid over the bodies' bounds with cloud-in-cell weights.
+    //   2. The potential is the convolution of that grid with the Green's function -G / r, done with FFTs on a
+    //      grid padded to twice the size (Hockney), so boundaries are isolated rather than periodic.
+    //   3. The acceleration is the central difference of the potential, interpolated back with the same weights.
+    //
+    // Cost is O(n + M log M) for M mesh cells. The mesh cannot resolve distances below a couple of cells; with
+    // splitScale > 0 the Green's function is split P3M style: the mesh carries -G erf(r / 2s) / r and pairs
+    // closer than cutoffFactor * s add the erfc remainder directly, found through a cell list.
+    //
+    // Every pass runs on the pool when one is attached, and each output cell or body is written by one task
+    // only, so results do not depend on the thread count. The FFT works in double with library twiddles,
+    // so unlike the rest of the engine it is not bit-identical across platforms.
+    template<typename T>
+    struct ParticleMeshGravity {
+        T cellSize = 16;                // px; grown if the bounds would need more than maxGridSize cells per axis
+        std::size_t maxGridSize = 1024;
+        T splitScale = 0;               // px; 0 disables the short-range correction
+        T cutoffFactor = T(4.5);        // short-range pairs within cutoffFactor * splitScale
+        ThreadPool* pool = nullptr;     // may be the pool the world is stepped on; nested passes then run inline
+
+        void Accumulate(std::vector<Object<T>>& bodies, const ForceContext<T>&) const {
+            if (bodies.size() < 2) return;
+            Setup(bodies);
+            Deposit(bodies);
+            SolvePotential();
+            Differentiate();
+            Interpolate(bodies);
+            if (splitScale > 0) ShortRange(bodies);
+        }
+
+    private:
+        using Complex = FFT::Complex;
+
+        // Scratch, reused between evaluations; the kernel itself is logically const
+        mutable std::size_t nx = 0, ny = 0;             // mesh cells covering the bodies
+        mutable double h = 0, originX = 0, originY = 0;
+        mutable std::vector<Complex> grid;              // padded 2nx * 2ny: mass, then potential
+        mutable std::vector<Complex> greenHat;          // transformed Green's function for (nx, ny, h, split)
+        mutable std::vector<Complex> twiddlesX, twiddlesY;
+        mutable double greenH = 0, greenSplit = -1;
+        mutable std::vector<double> accelX, accelY;     // nx * ny
+        mutable std::vector<double> shortX, shortY;     // per body
+        mutable std::vector<std::uint32_t> order, start, cursor;    // bodies bucketed by mesh row or short-range cell
+
+        template<typename Body>
+        void ForChunks(const std::size_t count, Body&& body) const {
+            constexpr std::size_t Chunk = 4096;
+            const std::size_t chunks = (count + Chunk - 1) / Chunk;
+            auto run = [&](const std::size_t c) {
+                for (std::size_t i = c * Chunk; i < std::min(count, (c + 1) * Chunk); i++) body(i);
+            };
+            if (pool) pool->ParallelFor(chunks, run);
+            else for (std::size_t c = 0; c < chunks; c++) run(c);
+        }
+
+        template<typename Body>
+        void ForRange(const std::size_t count, Body&& body) const {
+            if (pool) pool->ParallelFor(count, body);
+            else for (std::size_t i = 0; i < count; i++) body(i);
+        }
+
+        // Counting sort of bodies into buckets; order lists body indices bucket by bucket, stable in index
+        template<typename BucketOf>
+        void Bucket(const std::size_t bodyCount, const std::size_t buckets, BucketOf&& bucketOf) const {
+            start.assign(buckets + 1, 0);
+            for (std::size_t i = 0; i < bodyCount; i++) start[bucketOf(i) + 1]++;
+            for (std::size_t b = 0; b < buckets; b++) start[b + 1] += start[b];
+            order.resize(bodyCount);
+            cursor.assign(start.begin(), start.end() - 1);
+            for (std::size_t i = 0; i < bodyCount; i++) order[cursor[bucketOf(i)]++] = static_cast<std::uint32_t>(i);
+        }
+
+        void Setup(const std::vector<Object<T>>& bodies) const {
+            double minX = static_cast<double>(bodies[0].x), maxX = minX;
+            double minY = static_cast<double>(bodies[0].y), maxY = minY;
+            for (const auto& b : bodies) {
+                minX = std::min(minX, static_cast<double>(b.x));
+                maxX = std::max(maxX, static_cast<double>(b.x));
+                minY = std::min(minY, static_cast<double>(b.y));
+                maxY = std::max(maxY, static_cast<double>(b.y));
+            }
+
+            // One spare cell on each side keeps every CIC footprint and central difference inside the mesh
+            h = static_cast<double>(cellSize);
+            const double extent = std::max(maxX - minX, maxY - minY);
+            if (extent / h + 3 > static_cast<double>(maxGridSize)) h = extent / static_cast<double>(maxGridSize - 3);
+            nx = FFT::NextPowerOfTwo(static_cast<std::size_t>((maxX - minX) / h) + 3);
+            ny = FFT::NextPowerOfTwo(static_cast<std::size_t>((maxY - minY) / h) + 3);
+            originX = minX - h;
+            originY = minY - h;
+
+            const double split = static_cast<double>(splitScale);
+            if (greenHat.size() != 4 * nx * ny || greenH != h || greenSplit != split) BuildGreen(split);
+        }
+
+        // -G / r on the padded grid, wrapped so that offsets -n..n-1 are all present, then transformed.
+        // The r = 0 cell uses the limit of the split kernel, or half a cell of softening without a split.
+        void BuildGreen(const double split) const {
+            const std::size_t px = 2 * nx, py = 2 * ny;
+            twiddlesX = FFT::Twiddles(px);
+            twiddlesY = FFT::Twiddles(py);
+            greenHat.assign(px * py, Complex{});
+            const double G = Gravitational_Constant;
+
+            ForRange(py, [&](const std::size_t y) {
+                const double dy = static_cast<double>(y < ny ? y : py - y) * h;
+                for (std::size_t x = 0; x < px; x++) {
+                    const double dx = static_cast<double>(x < nx ? x : px - x) * h;
+                    const double r = std::sqrt(dx * dx + dy * dy);
+                    double g;
+                    if (split > 0) g = r > 0 ? -G * std::erf(r / (2 * split)) / r : -G / (split * std::sqrt(M_PI));
+                    else g = -G / std::max(r, h / 2);
+                    greenHat[y * px + x] = Complex{g, 0};
+                }
+            });
+            FFT::Transform2D(greenHat, px, py, twiddlesX, twiddlesY, false, pool);
+            greenH = h;
+            greenSplit = split;
+        }
+
+        // Bodies are bucketed by mesh row. A body in row r writes rows r and r + 1, so bands of rows are filled
+        // in two passes, even bands then odd bands, and no two tasks ever touch the same row.
+        void Deposit(const std::vector<Object<T>>& bodies) const {
+            const std::size_t px = 2 * nx;
+            grid.assign(px * 2 * ny, Complex{});
+
+            auto rowOf = [&](const std::size_t i) {
+                return static_cast<std::size_t>((static_cast<double>(bodies[i].y) - originY) / h);
+            };
+            Bucket(bodies.size(), ny, rowOf);
+
+            constexpr std::size_t BandRows = 4;
+            const std::size_t bands = (ny + BandRows - 1) / BandRows;
+            auto depositBand = [&](const std::size_t band) {
+                const std::size_t first = start[band * BandRows], last = start[std::min(ny, (band + 1) * BandRows)];
+                for (std::size_t k = first; k < last; k++) {
+                    const Object<T>& b = bodies[order[k]];
+                    const double fx = (static_cast<double>(b.x) - originX) / h, fy = (static_cast<double>(b.y) - originY) / h;
+                    const auto ix = static_cast<std::size_t>(fx), iy = static_cast<std::size_t>(fy);
+                    const double tx = fx - static_cast<double>(ix), ty = fy - static_cast<double>(iy);
+                    const double m = static_cast<double>(b.mass);
+                    grid[iy * px + ix] += m * (1 - tx) * (1 - ty);
+                    grid[iy * px + ix + 1] += m * tx * (1 - ty);
+                    grid[(iy + 1) * px + ix] += m * (1 - tx) * ty;
+                    grid[(iy + 1) * px + ix + 1] += m * tx * ty;
+                }
+            };
+            for (std::size_t parity = 0; parity < 2; parity++) {
+                ForRange((bands + 1 - parity) / 2, [&](const std::size_t k) { depositBand(2 * k + parity); });
+            }
+        }
+
+        void SolvePotential() const {
+            const std::size_t px = 2 * nx, py = 2 * ny;
+            FFT::Transform2D(grid, px, py, twiddlesX, twiddlesY, false, pool);
+            const double scale = 1.0 / static_cast<double>(px * py);
+            ForRange(py, [&](const std::size_t y) {
+                for (std::size_t x = 0; x < px; x++) grid[y * px + x] *= greenHat[y * px + x] * scale;
+            });
+            FFT::Transform2D(grid, px, py, twiddlesX, twiddlesY, true, pool);
+        }
+
+        // a = -grad(phi). Neighbours of the edge cells wrap into the padding, which holds the potential of the
+        // isolated system at those points.
+        void Differentiate() const {
+            const std::size_t px = 2 * nx, py = 2 * ny;
+            accelX.resize(nx * ny);
+            accelY.resize(nx * ny);
+            auto phi = [&](const std::size_t x, const std::size_t y) { return grid[(y % py) * px + x % px].real(); };
+            ForRange(ny, [&](const std::size_t y) {
+                for (std::size_t x = 0; x < nx; x++) {
+                    accelX[y * nx + x] = -(phi(x + 1, y) - phi(x + px - 1, y)) / (2 * h);
+                    accelY[y * nx + x] = -(phi(x, y + 1) - phi(x, y + py - 1)) / (2 * h);
+                }
+            });
+        }
+
+        void Interpolate(std::vector<Object<T>>& bodies) const {
+            ForChunks(bodies.size(), [&](const std::size_t i) {
+                Object<T>& b = bodies[i];
+                const double fx = (static_cast<double>(b.x) - originX) / h, fy = (static_cast<double>(b.y) - originY) / h;
+                const auto ix = static_cast<std::size_t>(fx), iy = static_cast<std::size_t>(fy);
+                const double tx = fx - static_cast<double>(ix), ty = fy - static_cast<double>(iy);
+                const std::size_t c = iy * nx + ix;
+                const double w00 = (1 - tx) * (1 - ty), w10 = tx * (1 - ty), w01 = (1 - tx) * ty, w11 = tx * ty;
+                const double ax = w00 * accelX[c] + w10 * accelX[c + 1] + w01 * accelX[c + nx] + w11 * accelX[c + nx + 1];
+                const double ay = w00 * accelY[c] + w10 * accelY[c + 1] + w01 * accelY[c + nx] + w11 * accelY[c + nx + 1];
+                b.acceleration += Vector2<T>{static_cast<T>(ax), static_cast<T>(ay)};
+            });
+        }
+
+        // The erfc part of the split force, for pairs within the cutoff. Each body sums its own neighbours,
+        // so pairs are visited twice but no two tasks write the same body.
+        void ShortRange(std::vector<Object<T>>& bodies) const {
+            const double split = static_cast<double>(splitScale);
+            const double cutoff = static_cast<double>(cutoffFactor) * split;
+            const double cutoffSquared = cutoff * cutoff;
+            const auto cellsX = static_cast<std::size_t>(static_cast<double>(nx) * h / cutoff) + 1;
+            const auto cellsY = static_cast<std::size_t>(static_cast<double>(ny) * h / cutoff) + 1;
+            auto cellX = [&](const double x) { return std::min(cellsX - 1, static_cast<std::size_t>((x - originX) / cutoff)); };
+            auto cellY = [&](const double y) { return std::min(cellsY - 1, static_cast<std::size_t>((y - originY) / cutoff)); };
+            Bucket(bodies.size(), cellsX * cellsY, [&](const std::size_t i) {
+                return cellY(static_cast<double>(bodies[i].y)) * cellsX + cellX(static_cast<double>(bodies[i].x));
+            });
+
+            const double G = Gravitational_Constant;
+            const double invSqrtPi = 1 / std::sqrt(M_PI);
+            shortX.resize(bodies.size());
+            shortY.resize(bodies.size());
+            ForChunks(bodies.size(), [&](const std::size_t i) {
+                const double x = static_cast<double>(bodies[i].x), y = static_cast<double>(bodies[i].y);
+                const std::size_t cx = cellX(x), cy = cellY(y);
+                double ax = 0, ay = 0;
+                for (std::size_t gy = cy > 0 ? cy - 1 : 0; gy <= std::min(cellsY - 1, cy + 1); gy++) {
+                    for (std::size_t gx = cx > 0 ? cx - 1 : 0; gx <= std::min(cellsX - 1, cx + 1); gx++) {
+                        const std::size_t cell = gy * cellsX + gx;
+                        for (std::size_t k = start[cell]; k < start[cell + 1]; k++) {
+                            const std::uint32_t j = order[k];
+                            if (j == i) continue;
+                            const double dx = static_cast<double>(bodies[j].x) - x, dy = static_cast<double>(bodies[j].y) - y;
+                            const double r2 = dx * dx + dy * dy;
+                            if (r2 >= cutoffSquared || r2 == 0) continue;
+                            const double r = std::sqrt(r2), u = r / (2 * split);
+                            const double factor = std::erfc(u) + 2 * u * invSqrtPi * std::exp(-u * u);
+                            const double s = G * static_cast<double>(bodies[j].mass) * factor / (r2 * r);
+                            ax += s * dx;
+                            ay += s * dy;
+                        }
+                    }
+                }
+                shortX[i] = ax;
+                shortY[i] = ay;
+            });
+            ForChunks(bodies.size(), [&](const std::size_t i) {
+                bodies[i].acceleration += Vector2<T>{static_cast<T>(shortX[i]), static_cast<T>(shortY[i])};
+            });
+        }
+    };
+
+    // The default forces plus gravity between bodies through the mesh
+    template<typename T>
+    using ParticleMeshForceField = ForceField<T, UniformGravity, FloorFriction<T>, LinearDrag<T>, ParticleMeshGravity<T>>;
+
+}
+
+#endif //PARTICLEMESH_H
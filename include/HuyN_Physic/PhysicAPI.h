@@ -0,0 +1,86 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PHYSICAPI_H
+#define PHYSICAPI_H
+
+// C interface of the huyn_physic library, for embedding the engine without its templates.
+// Everything works on flat arrays: one call adds, removes, steps or reads back any number of bodies.
+// Positions and velocities are interleaved pairs (x0, y0, x1, y1, ...), in px and px/s.
+
+// Fixed-point builds exchange the raw Q32.32 value (1.0 is 1 << 32), so replicated state stays bit exact.
+// The library must be built with the same precision macro; linking the huyn_physic CMake target carries it over,
+// and HuyNPhysic_GetPrecision() lets other consumers check against HUYN_PHYSIC_HEADER_PRECISION at run time.
+typedef enum HuyNPhysic_Precision {
+    HuyNPhysic_PrecisionDouble,
+    HuyNPhysic_PrecisionFloat,
+    HuyNPhysic_PrecisionFixed
+} HuyNPhysic_Precision;
+
+#if defined(HUYN_PHYSIC_PRECISION_FLOAT)
+typedef float HuyNPhysic_Real;
+#define HUYN_PHYSIC_HEADER_PRECISION HuyNPhysic_PrecisionFloat
+#elif defined(HUYN_PHYSIC_PRECISION_FIXED)
+typedef int64_t HuyNPhysic_Real;
+#define HUYN_PHYSIC_HEADER_PRECISION HuyNPhysic_PrecisionFixed
+#else
+typedef double HuyNPhysic_Real;
+#define HUYN_PHYSIC_HEADER_PRECISION HuyNPhysic_PrecisionDouble
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct HuyNPhysic_World HuyNPhysic_World;
+
+// Scalar the library was built with, and sizeof(HuyNPhysic_Real) as the library sees it
+HuyNPhysic_Precision HuyNPhysic_GetPrecision(void);
+size_t HuyNPhysic_RealSize(void);
+
+// Returns NULL on failure
+HuyNPhysic_World* HuyNPhysic_CreateWorld(HuyNPhysic_Real width, HuyNPhysic_Real height, HuyNPhysic_Real floorOffset);
+void HuyNPhysic_DestroyWorld(HuyNPhysic_World* world);
+
+// Reserves room for this many bodies; adds below it, and every step afterwards, do not allocate
+void HuyNPhysic_Reserve(HuyNPhysic_World* world, size_t bodies);
+
+void HuyNPhysic_SetGravity(HuyNPhysic_World* world, HuyNPhysic_Real x, HuyNPhysic_Real y);
+void HuyNPhysic_SetTickInterval(HuyNPhysic_World* world, uint64_t milliseconds);
+
+// velocities may be NULL (at rest). ids, if not NULL, receives one id per body.
+// Returns the number of bodies added, which is less than count only if memory ran out.
+size_t HuyNPhysic_AddCircles(HuyNPhysic_World* world, size_t count, const HuyNPhysic_Real* positions,
+                             const HuyNPhysic_Real* velocities, const HuyNPhysic_Real* radii,
+                             const HuyNPhysic_Real* masses, uint32_t* ids);
+
+// sizes are (width, height) pairs; boxes are centred on their position
+size_t HuyNPhysic_AddBoxes(HuyNPhysic_World* world, size_t count, const HuyNPhysic_Real* positions,
+                           const HuyNPhysic_Real* velocities, const HuyNPhysic_Real* sizes,
+                           const HuyNPhysic_Real* masses, uint32_t* ids);
+
+// Unknown ids are skipped. Returns the number of bodies removed. Removal reorders the remaining bodies.
+size_t HuyNPhysic_RemoveBodies(HuyNPhysic_World* world, size_t count, const uint32_t* ids);
+
+// Advances the world by ticks steps of the tick interval each.
+// Returns the number of steps completed, which is less than ticks only if a step failed (out of memory).
+uint64_t HuyNPhysic_Step(HuyNPhysic_World* world, uint64_t ticks);
+
+size_t HuyNPhysic_BodyCount(const HuyNPhysic_World* world);
+uint64_t HuyNPhysic_Tick(const HuyNPhysic_World* world);
+
+// Copies up to capacity bodies, in internal order, into the buffers that are not NULL.
+// Returns the number of bodies written.
+size_t HuyNPhysic_ReadState(const HuyNPhysic_World* world, size_t capacity, uint32_t* ids,
+                            HuyNPhysic_Real* positions, HuyNPhysic_Real* velocities);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PHYSICAPI_H
@@ -3,7 +3,9 @@
 //
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 #include "Vector2.h"
 #include "BaseShape.h"
@@ -25,6 +27,8 @@ namespace HuyNPhysic {
         Vector2<T> velocity;        // pixels per second
         Vector2<T> acceleration;
         T mass;
+        std::uint32_t id{};         // stable body ID, used to key cached contacts
+        std::uint32_t groups = 1;   // bit set of the groups the body belongs to, for filtering contact events
 
         Shape::BaseShape<T>* shape;
 
@@ -41,7 +45,7 @@ namespace HuyNPhysic {
         // Copy constructor
         Object(const Object& other) :
             x(other.x), y(other.y), velocity(other.velocity),
-            acceleration(other.acceleration), mass(other.mass),
+            acceleration(other.acceleration), mass(other.mass), id(other.id), groups(other.groups),
             shape(other.shape->clone()) {}
 
         // Assignment operator
@@ -52,12 +56,39 @@ namespace HuyNPhysic {
                 velocity = other.velocity;
                 acceleration = other.acceleration;
                 mass = other.mass;
+                id = other.id;
+                groups = other.groups;
                 delete shape;
                 shape = other.shape->clone();
             }
             return *this;
         }
 
+        // Move constructor: takes the shape instead of cloning it, so storage can be reordered cheaply
+        Object(Object&& other) noexcept :
+            x(other.x), y(other.y), velocity(other.velocity),
+            acceleration(other.acceleration), mass(other.mass), id(other.id), groups(other.groups),
+            shape(other.shape) {
+            other.shape = nullptr;
+        }
+
+        // Move assignment
+        Object& operator=(Object&& other) noexcept {
+            if (this != &other) {
+                x = other.x;
+                y = other.y;
+                velocity = other.velocity;
+                acceleration = other.acceleration;
+                mass = other.mass;
+                id = other.id;
+                groups = other.groups;
+                delete shape;
+                shape = other.shape;
+                other.shape = nullptr;
+            }
+            return *this;
+        }
+
         // Destructor
         ~Object() {
             delete shape;
@@ -69,21 +100,42 @@ namespace HuyNPhysic {
 
         // ********************************** BASIC PHYSIC FUNCTIONS ********************************* //
 
+        // Adds to the current acceleration only: World's force pass overwrites accelerations every evaluation,
+        // so forces that should persist belong in a ForceField kernel
         void ApplyingForce(Vector2<T> force) {
             acceleration += force / mass;
         }
 
-        void PhysicStep(T TickPassed, bool applyFriction = false, T frictionCoefficient = 0.1) {
+        // Semi-implicit Euler for a single body. Whole-scene stepping goes through the policies in Integrator.h.
+        void PhysicStep(T TickPassed, bool applyFriction = false, T frictionCoefficient = 0.1, T dragCoefficient = 0) {
             // 1 tick = 1 ms
-            velocity += acceleration * TickPassed / 1000.0;
+            const T dt = TickPassed / T(1000);
+            velocity += acceleration * dt;
+
+            if (applyFriction) ApplyFriction(dt, frictionCoefficient);
+            ApplyDrag(dt, dragCoefficient);
 
             // velocity applied as pixels per second as default
-            x += velocity.x * TickPassed / 1000.0;
-            y += velocity.y * TickPassed / 1000.0;
+            x += velocity.x * dt;
+            y += velocity.y * dt;
 
             syncShapePosition();
         }
 
+        // Kinetic friction against the floor: the normal load is the downward part of the acceleration.
+        // Slows horizontal motion and stops it, but never reverses it.
+        void ApplyFriction(T dt, T frictionCoefficient) {
+            const T deltaV = frictionCoefficient * std::max(acceleration.y, T(0)) * dt;
+            using std::abs;
+            if (abs(velocity.x) <= deltaV) velocity.x = 0;
+            else velocity.x -= velocity.x > 0 ? deltaV : -deltaV;
+        }
+
+        // Linear drag, integrated implicitly so large coefficients stay stable
+        void ApplyDrag(T dt, T dragCoefficient) {
+            if (dragCoefficient > 0) velocity /= (1 + dragCoefficient * dt);
+        }
+
         void handleBoundaries(T minX, T maxX, T minY, T maxY) {
             if (const char type = shape->getType(); type == 'c') {
                 auto* circle = dynamic_cast<Shape::Circle<T>*>(shape);
@@ -171,8 +223,8 @@ namespace HuyNPhysic {
     bool circleRect(Shape::Circle<T> cir, Shape::Box<T> rect) {
 
         // temporary variables to set edges for testing
-        float testX = cir.x;
-        float testY = cir.y;
+        T testX = cir.x;
+        T testY = cir.y;
 
         // which edge is closest?
         if (cir.x < rect.x) testX = rect.x;      // test left edge
@@ -181,9 +233,10 @@ namespace HuyNPhysic {
         else if (cir.y > rect.getBottom()) testY = rect.getBottom();   // bottom edge
 
         // get distance from the closest edges
-        float distX = cir.x - testX;
-        float distY = cir.y - testY;
-        float distance = std::sqrt((distX*distX) + (distY*distY));
+        T distX = cir.x - testX;
+        T distY = cir.y - testY;
+        using std::sqrt;
+        T distance = sqrt((distX*distX) + (distY*distY));
 
         // if the distance is less than the radius, collision!
         if (distance <= cir.radius) return true;
@@ -239,7 +292,7 @@ namespace HuyNPhysic {
     Vector2<T> vDiff = passive_obj->velocity - proactive_obj->velocity;
     Vector2<T> vPosSub = passive_obj->Vector2Position() - proactive_obj->Vector2Position();
     T vDist = vPosSub.magnitude();
-    if (vDist == 0) vDist = 1e-6; // Prevent division by zero
+    if (vDist == 0) vDist = T(1e-6); // Prevent division by zero
     Vector2<T> normal = vPosSub / vDist; // Collision normal
 
     // Velocity impulse
@@ -315,10 +368,10 @@ namespace HuyNPhysic {
         Vector2<T> direction = Vector2<T>{obj2->x, obj2->y} - Vector2<T>{obj1->x, obj1->y};
         T distance = direction.magnitude();
         // Prevent division by zero
-        if (distance < 1e-6) distance = 1e-6;
+        if (distance < T(1e-6)) distance = T(1e-6);
 
         // Calculate force magnitude
-        T forceMagnitude = Gravitational_Constant * (obj1->mass * obj2->mass) / (distance * distance);
+        T forceMagnitude = static_cast<T>(Gravitational_Constant) * (obj1->mass * obj2->mass) / (distance * distance);
 
         // Return force vector
         return direction.normalize() * forceMagnitude;
@@ -329,7 +382,7 @@ namespace HuyNPhysic {
         Vector2<T> Force_Against_Each_Other = GravitationalForce(object, other);
 
         object->acceleration += Newtons_second_law_acceleration(Force_Against_Each_Other, object);
-        other->acceleration += Newtons_second_law_acceleration(Force_Against_Each_Other, other);
+        other->acceleration -= Newtons_second_law_acceleration(Force_Against_Each_Other, other);
     }
 
 }
@@ -0,0 +1,26 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include "FixedPoint.h"
+
+#ifndef PRECISION_H
+#define PRECISION_H
+
+namespace HuyNPhysic {
+
+    // Scalar type the application instantiates the engine with.
+    // Selected at configure time through the PHYSIC_PRECISION CMake cache variable.
+    // fixed gives bit-identical runs across machines, for lockstep replays that only exchange inputs.
+#if defined(HUYN_PHYSIC_PRECISION_FLOAT)
+    using Real = float;
+#elif defined(HUYN_PHYSIC_PRECISION_FIXED)
+    using Real = Fixed;
+#else
+    using Real = double;
+#endif
+
+}
+
+#endif //PRECISION_H
@@ -0,0 +1,233 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "AllocationTracker.h"
+#include "World.h"
+
+#ifndef REWINDBUFFER_H
+#define REWINDBUFFER_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    // Everything needed to rebuild one body. Plain bytes, so unchanged state is found with memcmp.
+    template<typename T>
+    struct BodyState {
+        std::uint32_t id;
+        std::uint32_t groups;
+        char type;                      // 'c' or 'b', as BaseShape::getType()
+        T x, y;
+        T vx, vy;
+        T ax, ay;
+        T mass;
+        T width, height;                // circle: width = radius
+    };
+
+    // The last N ticks of body state, for scrubbing back and forth.
+    // Each recorded tick is a list of shared chunks of ChunkSize bodies in storage order. A chunk whose bytes
+    // did not change since the previous tick is shared with it instead of copied, so resting or sparse scenes
+    // cost a few pointers per tick and memory grows with how much moves, not with ticks times bodies.
+    // Chunks that fall out of the ring are kept and refilled, so once it is full, recording allocates nothing.
+    // Only bodies, their ids and the tick are rewound. The solver's contacts and cache are dropped on restore, so
+    // resuming from a rewound tick starts without warm-started contacts; walls, world parameters and integrator
+    // state stay as they are.
+    template<typename T>
+    class RewindBuffer {
+    public:
+        static constexpr std::size_t ChunkSize = 256;
+        using Chunk = std::vector<BodyState<T>>;
+
+        static_assert(std::is_trivially_copyable_v<BodyState<T>>, "chunks are compared with memcmp");
+
+        explicit RewindBuffer(const std::size_t capacity) : frames(std::max<std::size_t>(capacity, 2)) {}
+
+        [[nodiscard]] std::size_t Capacity() const noexcept { return frames.size(); }
+        [[nodiscard]] std::size_t Size() const noexcept { return count; }
+
+        // Position of the world relative to the newest recorded tick: 0, or negative after stepping back
+        [[nodiscard]] std::int64_t Offset() const noexcept {
+            return count == 0 ? 0 : static_cast<std::int64_t>(cursor) - static_cast<std::int64_t>(count - 1);
+        }
+
+        // Chunks the last Record had to copy; the rest were shared with the tick before
+        [[nodiscard]] std::size_t LastCopiedChunks() const noexcept { return lastCopied; }
+
+        // Records the world as it is now, normally right after a step. Ticks after the cursor, left over from
+        // stepping back, are dropped first: the world has moved on from the rewound tick.
+        template<typename IntegratorPolicy, typename Forces>
+        void Record(const World<T, IntegratorPolicy, Forces>& world) {
+            if (count > 0) count = cursor + 1;
+            const Frame* previous = count > 0 ? &At(count - 1) : nullptr;
+            if (count == frames.size()) {
+                first = (first + 1) % frames.size();
+                count--;
+            }
+            HUYN_PHYSIC_ALLOCATION_PHASE(Rewind);
+            // The oldest tick's slot; never the previous one, as the ring holds at least two
+            Frame& frame = At(count);
+            std::vector<std::shared_ptr<const Chunk>>& chunks = frame.chunks;
+            Retire(chunks);
+
+            const std::vector<Object<T>>& objects = world.objects;
+            const std::size_t chunkCount = (objects.size() + ChunkSize - 1) / ChunkSize;
+            chunks.reserve(chunkCount);
+            lastCopied = 0;
+            for (std::size_t c = 0; c < chunkCount; c++) {
+                const std::size_t begin = c * ChunkSize;
+                const std::size_t size = std::min(ChunkSize, objects.size() - begin);
+                std::shared_ptr<Chunk> chunk = TakeChunk();
+                chunk->resize(size);
+                std::memset(static_cast<void*>(chunk->data()), 0, size * sizeof(BodyState<T>));
+                for (std::size_t i = 0; i < size; i++) Capture(objects[begin + i], (*chunk)[i]);
+
+                if (previous && c < previous->chunks.size() && previous->chunks[c]->size() == size &&
+                    std::memcmp(previous->chunks[c]->data(), chunk->data(), size * sizeof(BodyState<T>)) == 0) {
+                    chunks.push_back(previous->chunks[c]);
+                    spare.push_back(std::move(chunk));
+                } else {
+                    chunks.push_back(std::move(chunk));
+                    lastCopied++;
+                }
+            }
+
+            frame.tick = world.tick;
+            frame.nextId = world.NextId();
+            frame.bodies = objects.size();
+            count++;
+            cursor = count - 1;
+        }
+
+        // Moves by ticks recorded ticks (negative is back in time), clamped to what is recorded, and puts the
+        // world in that state. Returns the number of ticks actually moved.
+        template<typename IntegratorPolicy, typename Forces>
+        std::int64_t Seek(World<T, IntegratorPolicy, Forces>& world, const std::int64_t ticks) {
+            if (count == 0) return 0;
+            const std::int64_t target = std::clamp(static_cast<std::int64_t>(cursor) + ticks, std::int64_t{0},
+                                                   static_cast<std::int64_t>(count - 1));
+            const std::int64_t moved = target - static_cast<std::int64_t>(cursor);
+            cursor = static_cast<std::size_t>(target);
+            Restore(world, At(cursor));
+            return moved;
+        }
+
+    private:
+        struct Frame {
+            std::uint64_t tick = 0;
+            std::uint32_t nextId = 0;
+            std::size_t bodies = 0;
+            std::vector<std::shared_ptr<const Chunk>> chunks{};
+        };
+
+        std::vector<Frame> frames;      // ring
+        std::size_t first = 0;          // slot of the oldest tick
+        std::size_t count = 0;
+        std::size_t cursor = 0;         // tick the world was last recorded at or rewound to, counted from the oldest
+        std::size_t lastCopied = 0;
+        std::vector<std::shared_ptr<Chunk>> spare{};     // chunks no frame refers to, ready to be refilled
+
+        [[nodiscard]] Frame& At(const std::size_t i) { return frames[(first + i) % frames.size()]; }
+
+        // Empties a frame being overwritten, keeping the chunks no other frame shares.
+        // Chunks are only ever written before they are published, so handing them out again is safe.
+        void Retire(std::vector<std::shared_ptr<const Chunk>>& chunks) {
+            for (auto& chunk : chunks) {
+                if (chunk.use_count() == 1) spare.push_back(std::const_pointer_cast<Chunk>(std::move(chunk)));
+            }
+            chunks.clear();
+        }
+
+        [[nodiscard]] std::shared_ptr<Chunk> TakeChunk() {
+            if (spare.empty()) {
+                auto chunk = std::make_shared<Chunk>();
+                chunk->reserve(ChunkSize);
+                return chunk;
+            }
+            std::shared_ptr<Chunk> chunk = std::move(spare.back());
+            spare.pop_back();
+            return chunk;
+        }
+
+        static void Capture(const Object<T>& obj, BodyState<T>& s) {
+            s.id = obj.id;
+            s.groups = obj.groups;
+            s.type = obj.shape->getType();
+            s.x = obj.x;
+            s.y = obj.y;
+            s.vx = obj.velocity.x;
+            s.vy = obj.velocity.y;
+            s.ax = obj.acceleration.x;
+            s.ay = obj.acceleration.y;
+            s.mass = obj.mass;
+            if (s.type == 'c') {
+                s.width = s.height = dynamic_cast<Shape::Circle<T>*>(obj.shape)->radius;
+            } else if (s.type == 'b') {
+                const auto* box = dynamic_cast<Shape::Box<T>*>(obj.shape);
+                s.width = box->width;
+                s.height = box->height;
+            }
+        }
+
+        // Writes the state into an existing body when the shape type matches, so scrubbing over a stable set
+        // of bodies does not allocate
+        static void Apply(const BodyState<T>& s, Object<T>& obj) {
+            obj.x = s.x;
+            obj.y = s.y;
+            obj.velocity = Vector2<T>{s.vx, s.vy};
+            obj.acceleration = Vector2<T>{s.ax, s.ay};
+            obj.mass = s.mass;
+            obj.id = s.id;
+            obj.groups = s.groups;
+            if (s.type == 'c') {
+                dynamic_cast<Shape::Circle<T>*>(obj.shape)->radius = s.width;
+            } else if (s.type == 'b') {
+                auto* box = dynamic_cast<Shape::Box<T>*>(obj.shape);
+                box->width = s.width;
+                box->height = s.height;
+            }
+            obj.syncShapePosition();
+        }
+
+        static Object<T> Make(const BodyState<T>& s) {
+            Shape::Circle<T> circle{s.x, s.y, s.width};
+            Shape::Box<T> box{s.x, s.y, s.width, s.height};
+            Object<T> obj{s.x, s.y, s.mass, s.type == 'b' ? static_cast<Shape::BaseShape<T>*>(&box) : &circle};
+            Apply(s, obj);
+            return obj;
+        }
+
+        template<typename IntegratorPolicy, typename Forces>
+        static void Restore(World<T, IntegratorPolicy, Forces>& world, const Frame& frame) {
+            std::vector<Object<T>>& objects = world.objects;
+            while (objects.size() > frame.bodies) objects.pop_back();
+
+            std::size_t i = 0;
+            for (const auto& chunk : frame.chunks) {
+                for (const BodyState<T>& s : *chunk) {
+                    if (i < objects.size()) {
+                        if (objects[i].shape->getType() == s.type) Apply(s, objects[i]);
+                        else objects[i] = Make(s);
+                    } else {
+                        objects.push_back(Make(s));
+                    }
+                    i++;
+                }
+            }
+
+            world.tick = frame.tick;
+            world.RestoreIds(frame.nextId);
+        }
+    };
+
+}
+
+#endif //REWINDBUFFER_H
@@ -0,0 +1,161 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "PhysicEngine.h"
+
+#ifndef SCENESPAWNER_H
+#define SCENESPAWNER_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    template<typename T>
+    struct SpawnSettings {
+        // Spawn region; bodies are placed fully inside it
+        T minX, minY, maxX, maxY;
+
+        std::size_t count;
+        T minRadius, maxRadius;         // circle radius, or half diagonal of a square box
+        T boxFraction = 0;              // share of bodies spawned as boxes, 0..1
+        T minDensity = T(0.001), maxDensity = T(0.001);    // mass = density * area
+        T maxSpeed = 0;                 // initial speed is uniform in [0, maxSpeed], random direction
+        T gap = 0;                      // extra clearance between neighbours
+        int attempts = 30;              // candidates tried around an active body before it is retired
+        std::uint64_t seed = 0;
+    };
+
+
+    // ************************************* POISSON-DISK SPAWNER ************************************* //
+
+    // Bridson-style Poisson-disk sampling with variable radii.
+    // The background grid uses cells of side 2 * minRadius / sqrt(2), so a cell holds at most one centre and a
+    // candidate of radius r only has to look at the cells within r + maxRadius + gap of it: O(count) overall.
+    // Spawning stops early, instead of looping forever, once no active body has room left around it.
+    // Returns the number of bodies appended to objects.
+    template<typename T>
+    std::size_t SpawnScene(std::vector<Object<T>>& objects, const SpawnSettings<T>& settings) {
+        if (settings.count == 0 || settings.minRadius <= 0 || settings.maxRadius < settings.minRadius) return 0;
+        if (settings.maxX - settings.minX < 2 * settings.maxRadius ||
+            settings.maxY - settings.minY < 2 * settings.maxRadius) return 0;
+
+        // Portable uniform numbers, so one seed gives the same scene on every standard library
+        std::mt19937_64 rng(settings.seed);
+        auto uniform = [&rng](T lo, T hi) {
+            const double u = static_cast<double>(rng() >> 11) * 0x1.0p-53;
+            return lo + static_cast<T>(u * static_cast<double>(hi - lo));
+        };
+
+        using std::sqrt, std::ceil, std::cos, std::sin;
+        const T cellSize = 2 * settings.minRadius / sqrt(T(2));
+        const T width = settings.maxX - settings.minX;
+        const T height = settings.maxY - settings.minY;
+        const auto gridW = static_cast<std::size_t>(ceil(width / cellSize)) + 1;
+        const auto gridH = static_cast<std::size_t>(ceil(height / cellSize)) + 1;
+
+        std::vector<std::int32_t> grid(gridW * gridH, -1);
+        std::vector<Vector2<T>> centres;
+        std::vector<T> radii;
+        std::vector<std::int32_t> active;
+        centres.reserve(settings.count);
+        radii.reserve(settings.count);
+
+        auto cellOf = [&](const Vector2<T>& p, long long& cx, long long& cy) {
+            cx = static_cast<long long>((p.x - settings.minX) / cellSize);
+            cy = static_cast<long long>((p.y - settings.minY) / cellSize);
+        };
+
+        auto fits = [&](const Vector2<T>& p, const T r) {
+            if (p.x - r < settings.minX || p.x + r > settings.maxX ||
+                p.y - r < settings.minY || p.y + r > settings.maxY) return false;
+
+            // Only centres closer than r + maxRadius + gap can overlap
+            const auto reach = static_cast<long long>(ceil((r + settings.maxRadius + settings.gap) / cellSize));
+            long long cx, cy;
+            cellOf(p, cx, cy);
+            for (long long gy = std::max(0LL, cy - reach); gy <= std::min<long long>(gridH - 1, cy + reach); gy++) {
+                for (long long gx = std::max(0LL, cx - reach); gx <= std::min<long long>(gridW - 1, cx + reach); gx++) {
+                    const std::int32_t other = grid[gy * gridW + gx];
+                    if (other < 0) continue;
+                    const Vector2<T> d = centres[other] - p;
+                    const T minDist = radii[other] + r + settings.gap;
+                    if (d.dot(d) < minDist * minDist) return false;
+                }
+            }
+            return true;
+        };
+
+        auto place = [&](const Vector2<T>& p, const T r) {
+            long long cx, cy;
+            cellOf(p, cx, cy);
+            const auto index = static_cast<std::int32_t>(centres.size());
+            grid[cy * gridW + cx] = index;
+            centres.push_back(p);
+            radii.push_back(r);
+            active.push_back(index);
+        };
+
+        T nextRadius = uniform(settings.minRadius, settings.maxRadius);
+        place(Vector2<T>{uniform(settings.minX + nextRadius, settings.maxX - nextRadius),
+                         uniform(settings.minY + nextRadius, settings.maxY - nextRadius)}, nextRadius);
+        nextRadius = uniform(settings.minRadius, settings.maxRadius);
+
+        while (!active.empty() && centres.size() < settings.count) {
+            const auto slot = static_cast<std::size_t>(rng() % active.size());
+            const std::int32_t parent = active[slot];
+
+            // Candidates in the annulus [R, 2R] around the parent, R being the touching distance
+            const T inner = radii[parent] + nextRadius + settings.gap;
+            bool placed = false;
+            for (int k = 0; k < settings.attempts; k++) {
+                const T angle = uniform(0, static_cast<T>(2 * M_PI));
+                const T dist = uniform(inner, 2 * inner);
+                const Vector2<T> candidate = centres[parent] + Vector2<T>{cos(angle), sin(angle)} * dist;
+                if (fits(candidate, nextRadius)) {
+                    place(candidate, nextRadius);
+                    nextRadius = uniform(settings.minRadius, settings.maxRadius);
+                    placed = true;
+                    break;
+                }
+            }
+
+            if (!placed) {
+                active[slot] = active.back();
+                active.pop_back();
+            }
+        }
+
+        // Build the bodies from the sampled discs
+        objects.reserve(objects.size() + centres.size());
+        for (std::size_t i = 0; i < centres.size(); i++) {
+            const T r = radii[i];
+            const bool isBox = settings.boxFraction > 0 && uniform(0, 1) < settings.boxFraction;
+            const T density = uniform(settings.minDensity, settings.maxDensity);
+            const T speed = uniform(0, settings.maxSpeed);
+            const T heading = uniform(0, static_cast<T>(2 * M_PI));
+            const Vector2<T> velocity = Vector2<T>{cos(heading), sin(heading)} * speed;
+
+            if (isBox) {
+                const T side = r * sqrt(T(2));
+                Shape::Box<T> box{centres[i], side, side};
+                objects.emplace_back(centres[i].x, centres[i].y, box.area() * density, &box, velocity.x, velocity.y);
+            } else {
+                Shape::Circle<T> circle{centres[i], r};
+                objects.emplace_back(centres[i].x, centres[i].y, circle.area() * density, &circle, velocity.x, velocity.y);
+            }
+            objects.back().id = static_cast<std::uint32_t>(objects.size() - 1);
+        }
+
+        return centres.size();
+    }
+
+}
+
+#endif //SCENESPAWNER_H
@@ -0,0 +1,100 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "World.h"
+
+#ifndef STATEBUFFER_H
+#define STATEBUFFER_H
+
+namespace HuyNPhysic {
+
+    // ************************************** RENDER SNAPSHOT ************************************** //
+
+    // What the renderer needs from one completed step, copied out so drawing never touches live bodies
+    template<typename T>
+    struct DrawItem {
+        char type;                      // 'c' circle, 'b' box, as BaseShape::getType()
+        T x, y;                         // centre
+        T width, height;                // circle: width = radius
+    };
+
+    template<typename T>
+    struct RenderSnapshot {
+        std::vector<DrawItem<T>> items{};
+        std::vector<Spatial::WallSegment<T>> walls{};
+        std::uint64_t wallsVersion = ~0ULL;     // walls are only recopied when the world's walls changed
+        std::uint64_t tick = 0;
+        T width = 0;
+        T floor = 0;
+        Diagnostics<T> diagnostics{};   // last collected values, if the world has diagnostics enabled
+    };
+
+    template<typename T, typename IntegratorPolicy, typename Forces>
+    void CaptureSnapshot(const World<T, IntegratorPolicy, Forces>& world, RenderSnapshot<T>& snapshot) {
+        HUYN_PHYSIC_ALLOCATION_PHASE(Snapshot);
+        snapshot.items.clear();
+        snapshot.items.reserve(world.objects.size());
+        for (const auto& o : world.objects) {
+            const char type = o.shape->getType();
+            if (type == 'c') {
+                const auto* circle = dynamic_cast<Shape::Circle<T>*>(o.shape);
+                snapshot.items.push_back(DrawItem<T>{type, o.x, o.y, circle->radius, circle->radius});
+            } else if (type == 'b') {
+                const auto* box = dynamic_cast<Shape::Box<T>*>(o.shape);
+                snapshot.items.push_back(DrawItem<T>{type, o.x, o.y, box->width, box->height});
+            }
+        }
+        if (snapshot.wallsVersion != world.walls.Version()) {
+            snapshot.walls = world.walls.Segments();
+            snapshot.wallsVersion = world.walls.Version();
+        }
+        snapshot.tick = world.tick;
+        snapshot.width = world.width;
+        snapshot.floor = world.Floor();
+        snapshot.diagnostics = world.diagnostics.last;
+    }
+
+
+    // *************************************** TRIPLE BUFFER *************************************** //
+
+    // Lock-free hand-off between one writer (physics) and one reader (render).
+    // The writer fills WriteBuffer() and calls Publish(); the reader calls Acquire() and draws ReadBuffer().
+    // Three slots mean neither side ever waits: the writer always has a free slot, and the reader always
+    // holds the newest completed one until a newer one is published.
+    template<typename S>
+    class TripleBuffer {
+    public:
+        [[nodiscard]] S& WriteBuffer() noexcept { return buffers[back]; }
+
+        void Publish() noexcept {
+            back = middle.exchange(back | Fresh, std::memory_order_acq_rel) & IndexMask;
+        }
+
+        // Returns true if a newer buffer was taken; otherwise ReadBuffer() keeps the previous one
+        bool Acquire() noexcept {
+            if (!(middle.load(std::memory_order_relaxed) & Fresh)) return false;
+            front = middle.exchange(front, std::memory_order_acq_rel) & IndexMask;
+            return true;
+        }
+
+        [[nodiscard]] const S& ReadBuffer() const noexcept { return buffers[front]; }
+
+    private:
+        static constexpr std::uint8_t IndexMask = 0x3;
+        static constexpr std::uint8_t Fresh = 0x4;
+
+        S buffers[3]{};
+        std::atomic<std::uint8_t> middle{1};
+        std::uint8_t back = 0;          // owned by the writer
+        std::uint8_t front = 2;         // owned by the reader
+    };
+
+}
+
+#endif //STATEBUFFER_H
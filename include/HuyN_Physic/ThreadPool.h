@@ -0,0 +1,135 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+namespace HuyNPhysic {
+
+    // Fixed set of worker threads running one ParallelFor at a time.
+    // Indices are handed out through an atomic counter, so uneven work (worlds of different sizes,
+    // tiles with different amounts of geometry) balances itself. The calling thread takes part as well.
+    // Jobs are passed as a pointer to the caller's function object, so dispatching never allocates.
+    // A ParallelFor issued from inside one of this pool's tasks (a world stepped by RunBatch whose diagnostics or
+    // mesh use the same pool) runs inline on that thread instead of waiting on workers that are all busy.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency()) {
+            threads = std::max(threads, 1u);
+            workers.reserve(threads - 1);
+            for (unsigned i = 0; i + 1 < threads; i++) {
+                workers.emplace_back([this] { WorkerLoop(); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& w : workers) w.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] unsigned size() const noexcept { return static_cast<unsigned>(workers.size()) + 1; }
+
+        // Calls fn(i) for every i in [0, count) and returns once all calls have finished
+        template<typename Fn>
+        void ParallelFor(const std::size_t count, Fn&& fn) {
+            if (count == 0) return;
+            if (workers.empty() || count == 1 || runningPool == this) {
+                for (std::size_t i = 0; i < count; i++) fn(i);
+                return;
+            }
+
+            using Function = std::remove_reference_t<Fn>;
+            const Job job_{const_cast<void*>(static_cast<const void*>(&fn)),
+                           [](void* f, const std::size_t i) { (*static_cast<Function*>(f))(i); }};
+            {
+                std::lock_guard lock(mutex);
+                job = &job_;
+                jobSize = count;
+                next.store(0, std::memory_order_relaxed);
+                busy = static_cast<unsigned>(workers.size());
+                ++generation;
+            }
+            wake.notify_all();
+
+            RunJob(job_, count);
+
+            std::unique_lock lock(mutex);
+            done.wait(lock, [this] { return busy == 0; });
+            job = nullptr;
+        }
+
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+
+        struct Job {
+            void* function;
+            void (*invoke)(void*, std::size_t);
+        };
+
+        static inline thread_local const ThreadPool* runningPool = nullptr;    // pool whose task this thread runs
+
+        const Job* job = nullptr;
+        std::size_t jobSize = 0;
+        std::atomic<std::size_t> next{0};
+        unsigned busy = 0;
+        std::uint64_t generation = 0;
+        bool stopping = false;
+
+        void RunJob(const Job& fn, const std::size_t count) {
+            const ThreadPool* outer = runningPool;
+            runningPool = this;
+            for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                fn.invoke(fn.function, i);
+            }
+            runningPool = outer;
+        }
+
+        void WorkerLoop() {
+            std::uint64_t seen = 0;
+            while (true) {
+                const Job* fn;
+                std::size_t count;
+                {
+                    std::unique_lock lock(mutex);
+                    wake.wait(lock, [&] { return stopping || generation != seen; });
+                    if (stopping) return;
+                    seen = generation;
+                    fn = job;
+                    count = jobSize;
+                }
+
+                RunJob(*fn, count);
+
+                {
+                    std::lock_guard lock(mutex);
+                    if (--busy == 0) done.notify_one();
+                }
+            }
+        }
+    };
+
+}
+
+#endif //THREADPOOL_H
@@ -63,7 +63,10 @@ namespace HuyNVector {
             return Vector2<T>(x * lhs, y * lhs);
         }
 
+        // Unqualified math calls, so scalar types with their own sqrt (Fixed) are found by ADL
+
         [[nodiscard]] T magnitude() const noexcept {
+            using std::sqrt;
             return sqrt(x * x + y * y);
         }
 
@@ -75,12 +78,14 @@ namespace HuyNVector {
             return (*this) / (magnitude() == 0 ? 1 : magnitude());
         }
 
-        [[nodiscard]] constexpr double distance(const Vector2<T>& _v) const noexcept {
-            return std::sqrt(std::pow(x - _v.x, 2) + std::pow(y - _v.y, 2));
+        [[nodiscard]] constexpr T distance(const Vector2<T>& _v) const noexcept {
+            using std::sqrt;
+            return sqrt((x - _v.x) * (x - _v.x) + (y - _v.y) * (y - _v.y));
         }
 
-        [[nodiscard]] double angleBetween(const Vector2<T>& _v) const noexcept {
-            return std::acos(this->dot(_v) / (this->magnitude() * _v.magnitude()));
+        [[nodiscard]] T angleBetween(const Vector2<T>& _v) const noexcept {
+            using std::acos;
+            return acos(this->dot(_v) / (this->magnitude() * _v.magnitude()));
         }
 
     };
@@ -0,0 +1,241 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "StaticBVH.h"
+#include "AllocationTracker.h"
+#include "PhysicEngine.h"
+#include "ContactSolver.h"
+#include "Integrator.h"
+#include "ForceField.h"
+#include "SceneSpawner.h"
+#include "Diagnostics.h"
+
+#ifndef WORLD_H
+#define WORLD_H
+
+using HuyNVector::Vector2;
+
+namespace HuyNPhysic {
+
+    // One self-contained sandbox: bodies, bounds, global parameters and solver state.
+    // Nothing is shared between worlds, so any number of them can be stepped on different threads.
+    template<typename T, typename IntegratorPolicy = Integrator::VelocityVerlet, typename Forces = DefaultForceField<T>>
+    class World {
+    public:
+        std::vector<Object<T>> objects{};
+
+        // Bounds: bodies are kept inside [0, width] x [0, Floor()]
+        T width;
+        T height;
+        T floorOffset;                  // distance from the bottom edge to the floor line
+
+        Spatial::StaticBVH<T> walls;    // user-drawn static geometry, rebuilt only when edited
+
+        Vector2<T> gravity{0, T(9.8)};
+        IntegratorPolicy integrator{};  // stateless for the fixed-step policies
+        Forces forces{};                // everything that sets accelerations; kernels are tuned via forces.Get<K>()
+        std::uint64_t tickInterval = 10; // ms per step
+        std::uint64_t tick = 0;         // steps taken so far
+
+        ContactSolver<T> solver{8};
+        DiagnosticsCollector<T> diagnostics; // off unless enabled; read diagnostics.last after a step
+
+        World(T width_, T height_, T floorOffset_ = 0) :
+            width(width_), height(height_), floorOffset(floorOffset_) {}
+
+        [[nodiscard]] T Floor() const { return height - floorOffset; }
+
+        void Resize(T width_, T height_) {
+            width = width_;
+            height = height_;
+        }
+
+        // ********************************* BODY MANAGEMENT ********************************* //
+
+        static constexpr std::uint32_t NoIndex = NoBodyIndex;
+
+        // Ids are handed out in order and never reused, so the id -> index table is a flat array
+        [[nodiscard]] std::uint32_t IndexOf(const std::uint32_t id) const noexcept {
+            return id < indexOfId.size() ? indexOfId[id] : NoIndex;
+        }
+
+        // Reserves room for the given number of bodies, so adds up to it do not reallocate, and for their
+        // contacts (packed circles touch at most six neighbours, so three contacts per body)
+        void Reserve(const std::size_t bodies) {
+            objects.reserve(bodies);
+            indexOfId.reserve(nextId + bodies);
+            solver.Reserve(3 * bodies);
+        }
+
+        std::uint32_t AddBody(const Object<T>& body) {
+            objects.push_back(body);
+            return Register(objects.size() - 1);
+        }
+
+        // Spawns a Poisson-disk scene into this world. Returns the number of bodies added.
+        std::size_t Spawn(const SpawnSettings<T>& settings) {
+            const std::size_t first = objects.size();
+            const std::size_t added = SpawnScene(objects, settings);
+            for (std::size_t i = first; i < objects.size(); i++) Register(i);
+            return added;
+        }
+
+        // Swaps the body with the last one and pops it. Returns false if the id is unknown.
+        bool RemoveBody(const std::uint32_t id) {
+            const std::uint32_t index = IndexOf(id);
+            if (index == NoIndex) return false;
+            if (index + 1 != objects.size()) {
+                objects[index] = std::move(objects.back());
+                indexOfId[objects[index].id] = index;
+            }
+            objects.pop_back();
+            indexOfId[id] = NoIndex;
+            accelerationsValid = false;
+            return true;
+        }
+
+        [[nodiscard]] std::uint32_t NextId() const noexcept { return nextId; }
+
+        // Rebuilds the id -> index table after objects was replaced wholesale with bodies keeping their ids
+        // (rewind); every id must be below nextId_. Stored accelerations are taken as they are. The solver's
+        // contacts and cached impulses belong to another timeline, so they are dropped.
+        void RestoreIds(const std::uint32_t nextId_) {
+            nextId = nextId_;
+            indexOfId.assign(nextId, NoIndex);
+            for (std::size_t i = 0; i < objects.size(); i++) indexOfId[objects[i].id] = static_cast<std::uint32_t>(i);
+            solver.Reset();
+            accelerationsValid = true;
+        }
+
+        // ************************************ SIMULATION ************************************ //
+
+        // Overwrites every acceleration from the force field, or only those of the listed bodies
+        void ComputeAccelerations(std::vector<Object<T>>& bodies, const std::vector<std::uint32_t>* active = nullptr) const {
+            const ForceContext<T> context{gravity, Floor(), Integrator::TickToSeconds(static_cast<T>(tickInterval)),
+                                          &indexOfId};
+            forces.Compute(bodies, context, active);
+        }
+
+        void Step() {
+            auto computeAccelerations = [this](std::vector<Object<T>>& bodies,
+                                               const std::vector<std::uint32_t>* active = nullptr) {
+                ComputeAccelerations(bodies, active);
+            };
+
+            // Steps allocate nothing once the buffers below have grown to the scene; the phases say where
+            // they still do (see AllocationTracker.h)
+            {
+                HUYN_PHYSIC_ALLOCATION_PHASE(Integration);
+                // Velocity Verlet reuses the previous step's accelerations, so start from a valid set
+                if (!accelerationsValid) {
+                    computeAccelerations(objects);
+                    accelerationsValid = true;
+                }
+                integrator.Step(objects, static_cast<T>(tickInterval), computeAccelerations);
+            }
+            {
+                HUYN_PHYSIC_ALLOCATION_PHASE(Boundaries);
+                const T floor = Floor();
+                for (auto& obj : objects) obj.handleBoundaries(0, width, 0, floor);
+                CollideWalls();
+            }
+
+            {
+                HUYN_PHYSIC_ALLOCATION_PHASE(Contacts);
+                solver.BeginStep();
+                for (std::size_t i = 0; i + 1 < objects.size(); i++) {
+                    for (std::size_t j = i + 1; j < objects.size(); j++) {
+                        solver.AddContact(objects, i, j);
+                    }
+                }
+            }
+            {
+                HUYN_PHYSIC_ALLOCATION_PHASE(Solver);
+                solver.Solve(objects, static_cast<T>(tickInterval), tick + 1);
+            }
+
+            ++tick;
+            if (diagnostics.enabled) {
+                HUYN_PHYSIC_ALLOCATION_PHASE(Diagnostics);
+                if constexpr (HasKernel<Forces, PairwiseGravity<T>>) {
+                    diagnostics.pairwiseCutoff = forces.template Get<PairwiseGravity<T>>().cutoff;
+                }
+                diagnostics.Collect(objects, solver.contacts, gravity, tick);
+            }
+        }
+
+        // Dynamic bodies against the static walls. Walls have infinite mass, so this is resolved directly:
+        // push the body out and remove (or, above the solver's restitution threshold, bounce) the normal velocity.
+        void CollideWalls() {
+            if (walls.Empty()) return;
+            walls.Update();
+
+            for (auto& obj : objects) {
+                const char shapeType = obj.shape->getType();
+                T halfWidth, halfHeight;
+                if (shapeType == 'c') {
+                    halfWidth = halfHeight = dynamic_cast<Shape::Circle<T>*>(obj.shape)->radius;
+                } else if (shapeType == 'b') {
+                    auto* box = dynamic_cast<Shape::Box<T>*>(obj.shape);
+                    halfWidth = box->width / 2;
+                    halfHeight = box->height / 2;
+                } else {
+                    continue;
+                }
+
+                const Spatial::AABB<T> bounds{obj.x - halfWidth, obj.y - halfHeight, obj.x + halfWidth, obj.y + halfHeight};
+                walls.Query(bounds, [&](const Spatial::WallSegment<T>& wall) {
+                    const Vector2<T> centre = obj.Vector2Position();
+                    Vector2<T> offset = centre - wall.ClosestPoint(centre);
+                    T distance = offset.magnitude();
+                    if (distance == 0) {
+                        // Centre exactly on the wall: push out along the segment normal
+                        offset = Vector2<T>{wall.a.y - wall.b.y, wall.b.x - wall.a.x}.normalize();
+                    } else {
+                        offset /= distance;
+                    }
+                    const Vector2<T> normal = offset;
+
+                    // Extent of the body towards the wall: the radius, or the box support along the normal
+                    using std::abs;
+                    const T extent = shapeType == 'c' ? halfWidth
+                                                      : abs(normal.x) * halfWidth + abs(normal.y) * halfHeight;
+                    const T penetration = extent + wall.thickness - distance;
+                    if (penetration <= 0) return;
+
+                    obj.x += normal.x * penetration;
+                    obj.y += normal.y * penetration;
+
+                    const T vn = obj.velocity.dot(normal);
+                    if (vn < 0) {
+                        const T bounce = vn < -solver.restitutionThreshold ? solver.restitution : 0;
+                        obj.velocity -= normal * ((1 + bounce) * vn);
+                    }
+                });
+                obj.syncShapePosition();
+            }
+        }
+
+    private:
+        std::uint32_t nextId = 0;
+        std::vector<std::uint32_t> indexOfId{};
+        bool accelerationsValid = false;
+
+        std::uint32_t Register(const std::size_t index) {
+            objects[index].id = nextId;
+            indexOfId.push_back(static_cast<std::uint32_t>(index));
+            accelerationsValid = false;
+            return nextId++;
+        }
+    };
+
+}
+
+#endif //WORLD_H
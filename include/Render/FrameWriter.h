@@ -0,0 +1,171 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "SoftwareRasterizer.h"
+
+#ifndef FRAMEWRITER_H
+#define FRAMEWRITER_H
+
+namespace Render {
+
+    // ******************************************* PPM ******************************************* //
+
+    // Binary P6, alpha dropped. Returns false if the file could not be written.
+    inline bool WritePPM(const std::string& path, const Framebuffer& fb) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+
+        std::fprintf(file, "P6\n%d %d\n255\n", fb.width, fb.height);
+        std::vector<std::uint8_t> row(static_cast<std::size_t>(fb.width) * 3);
+        bool ok = true;
+        for (int y = 0; y < fb.height && ok; y++) {
+            const std::uint32_t* src = fb.Row(y);
+            for (int x = 0; x < fb.width; x++) {
+                row[x * 3 + 0] = static_cast<std::uint8_t>(src[x]);
+                row[x * 3 + 1] = static_cast<std::uint8_t>(src[x] >> 8);
+                row[x * 3 + 2] = static_cast<std::uint8_t>(src[x] >> 16);
+            }
+            ok = std::fwrite(row.data(), 1, row.size(), file) == row.size();
+        }
+        return std::fclose(file) == 0 && ok;
+    }
+
+
+    // ******************************************* PNG ******************************************* //
+
+    namespace Detail {
+        inline const std::array<std::uint32_t, 256>& CrcTable() {
+            static const std::array<std::uint32_t, 256> table = [] {
+                std::array<std::uint32_t, 256> t{};
+                for (std::uint32_t n = 0; n < 256; n++) {
+                    std::uint32_t c = n;
+                    for (int k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    t[n] = c;
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        inline std::uint32_t Crc32(const std::uint8_t* data, const std::size_t size, std::uint32_t crc = 0xFFFFFFFFu) {
+            const auto& table = CrcTable();
+            for (std::size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            return crc;
+        }
+
+        inline void PutU32(std::vector<std::uint8_t>& out, const std::uint32_t v) {
+            out.push_back(static_cast<std::uint8_t>(v >> 24));
+            out.push_back(static_cast<std::uint8_t>(v >> 16));
+            out.push_back(static_cast<std::uint8_t>(v >> 8));
+            out.push_back(static_cast<std::uint8_t>(v));
+        }
+
+        inline void PutChunk(std::vector<std::uint8_t>& out, const char* type, const std::vector<std::uint8_t>& data) {
+            PutU32(out, static_cast<std::uint32_t>(data.size()));
+            const std::size_t start = out.size();
+            out.insert(out.end(), type, type + 4);
+            out.insert(out.end(), data.begin(), data.end());
+            PutU32(out, Crc32(out.data() + start, out.size() - start) ^ 0xFFFFFFFFu);
+        }
+    }
+
+    // RGBA PNG. The zlib stream uses stored (uncompressed) deflate blocks: files are large, but writing costs
+    // no more than a copy and needs no compression library. Pipe through an optimiser if size matters.
+    inline bool WritePNG(const std::string& path, const Framebuffer& fb) {
+        using namespace Detail;
+
+        // Scanlines, each prefixed with filter type 0
+        const std::size_t stride = static_cast<std::size_t>(fb.width) * 4 + 1;
+        std::vector<std::uint8_t> raw(stride * fb.height);
+        for (int y = 0; y < fb.height; y++) {
+            std::uint8_t* dst = raw.data() + stride * y;
+            dst[0] = 0;
+            const std::uint32_t* src = fb.Row(y);
+            for (int x = 0; x < fb.width; x++) {
+                dst[1 + x * 4 + 0] = static_cast<std::uint8_t>(src[x]);
+                dst[1 + x * 4 + 1] = static_cast<std::uint8_t>(src[x] >> 8);
+                dst[1 + x * 4 + 2] = static_cast<std::uint8_t>(src[x] >> 16);
+                dst[1 + x * 4 + 3] = static_cast<std::uint8_t>(src[x] >> 24);
+            }
+        }
+
+        std::vector<std::uint8_t> zlib{0x78, 0x01};
+        zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+        std::uint32_t adlerA = 1, adlerB = 0;
+        for (std::size_t pos = 0; pos < raw.size() || pos == 0;) {
+            const std::size_t len = std::min<std::size_t>(65535, raw.size() - pos);
+            const bool last = pos + len == raw.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<std::uint8_t>(len));
+            zlib.push_back(static_cast<std::uint8_t>(len >> 8));
+            zlib.push_back(static_cast<std::uint8_t>(~len));
+            zlib.push_back(static_cast<std::uint8_t>(~len >> 8));
+            for (std::size_t i = pos; i < pos + len; i++) {
+                adlerA = (adlerA + raw[i]) % 65521;
+                adlerB = (adlerB + adlerA) % 65521;
+            }
+            zlib.insert(zlib.end(), raw.begin() + static_cast<std::ptrdiff_t>(pos),
+                        raw.begin() + static_cast<std::ptrdiff_t>(pos + len));
+            pos += len;
+            if (last) break;
+        }
+        PutU32(zlib, adlerB << 16 | adlerA);
+
+        std::vector<std::uint8_t> header;
+        PutU32(header, static_cast<std::uint32_t>(fb.width));
+        PutU32(header, static_cast<std::uint32_t>(fb.height));
+        header.insert(header.end(), {8, 6, 0, 0, 0});  // 8 bit, RGBA, deflate, no filter, no interlace
+
+        std::vector<std::uint8_t> png{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        PutChunk(png, "IHDR", header);
+        PutChunk(png, "IDAT", zlib);
+        PutChunk(png, "IEND", {});
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        const bool ok = std::fwrite(png.data(), 1, png.size(), file) == png.size();
+        return std::fclose(file) == 0 && ok;
+    }
+
+
+    // **************************************** RAW VIDEO **************************************** //
+
+    // Concatenated RGBA frames with no header, e.g. for
+    //     ffmpeg -f rawvideo -pix_fmt rgba -s <w>x<h> -r <fps> -i - out.mp4
+    // Pass "-" to write to stdout.
+    class RawVideoWriter {
+    public:
+        explicit RawVideoWriter(const std::string& path) :
+            file(path == "-" ? stdout : std::fopen(path.c_str(), "wb")), ownsFile(path != "-") {}
+
+        ~RawVideoWriter() {
+            if (file && ownsFile) std::fclose(file);
+            else if (file) std::fflush(file);
+        }
+
+        RawVideoWriter(const RawVideoWriter&) = delete;
+        RawVideoWriter& operator=(const RawVideoWriter&) = delete;
+
+        [[nodiscard]] bool IsOpen() const noexcept { return file != nullptr; }
+
+        bool Write(const Framebuffer& fb) {
+            if (!file) return false;
+            return std::fwrite(fb.pixels.data(), sizeof(std::uint32_t), fb.pixels.size(), file) == fb.pixels.size();
+        }
+
+    private:
+        std::FILE* file;
+        bool ownsFile;
+    };
+
+}
+
+#endif //FRAMEWRITER_H
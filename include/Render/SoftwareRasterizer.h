@@ -0,0 +1,270 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "StateBuffer.h"
+#include "ThreadPool.h"
+
+#ifndef SOFTWARERASTERIZER_H
+#define SOFTWARERASTERIZER_H
+
+namespace Render {
+
+    // Pixels are stored R, G, B, A in memory, which is what PNG, PPM and rawvideo "rgba" expect.
+    // The shifts depend on the byte order, so the bytes land in that order on either kind of machine.
+    [[nodiscard]] constexpr std::uint32_t PackRGBA(const std::uint8_t r, const std::uint8_t g, const std::uint8_t b,
+                                                   const std::uint8_t a = 0xFF) noexcept {
+        static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big,
+                      "mixed-endian targets are not supported");
+        if constexpr (std::endian::native == std::endian::little) {
+            return static_cast<std::uint32_t>(r) | static_cast<std::uint32_t>(g) << 8 |
+                   static_cast<std::uint32_t>(b) << 16 | static_cast<std::uint32_t>(a) << 24;
+        } else {
+            return static_cast<std::uint32_t>(r) << 24 | static_cast<std::uint32_t>(g) << 16 |
+                   static_cast<std::uint32_t>(b) << 8 | static_cast<std::uint32_t>(a);
+        }
+    }
+
+    class Framebuffer {
+    public:
+        int width;
+        int height;
+        std::vector<std::uint32_t> pixels;
+
+        Framebuffer(const int width_, const int height_) :
+            width(width_), height(height_), pixels(static_cast<std::size_t>(width_) * height_) {}
+
+        [[nodiscard]] std::uint32_t* Row(const int y) noexcept { return pixels.data() + static_cast<std::size_t>(y) * width; }
+        [[nodiscard]] const std::uint32_t* Row(const int y) const noexcept {
+            return pixels.data() + static_cast<std::size_t>(y) * width;
+        }
+    };
+
+
+    // ************************************** SPAN FILLING ************************************** //
+
+    // Fills row[x0, x1) with one colour, eight or four pixels per store where the target supports it
+    inline void FillSpan(std::uint32_t* row, int x0, const int x1, const std::uint32_t color) noexcept {
+#if defined(__AVX2__)
+        const __m256i wide = _mm256_set1_epi32(static_cast<int>(color));
+        for (; x0 + 8 <= x1; x0 += 8) _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + x0), wide);
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i quad = _mm_set1_epi32(static_cast<int>(color));
+        for (; x0 + 4 <= x1; x0 += 4) _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x0), quad);
+#endif
+        for (; x0 < x1; x0++) row[x0] = color;
+    }
+
+    // Clipped to the rows [yMin, yMax) so that bands can be filled independently
+    inline void FillRect(Framebuffer& fb, const int left, const int top, const int right, const int bottom,
+                         const std::uint32_t color, const int yMin, const int yMax) noexcept {
+        const int x0 = std::max(left, 0), x1 = std::min(right, fb.width);
+        if (x0 >= x1) return;
+        for (int y = std::max(top, yMin); y < std::min(bottom, yMax); y++) FillSpan(fb.Row(y), x0, x1, color);
+    }
+
+    // One span per row, from the exact half chord at the pixel centre
+    template<typename T>
+    void FillCircle(Framebuffer& fb, const T cx, const T cy, const T radius, const std::uint32_t color,
+                    const int yMin, const int yMax) noexcept {
+        const int top = std::max(static_cast<int>(std::floor(static_cast<double>(cy - radius))), yMin);
+        const int bottom = std::min(static_cast<int>(std::ceil(static_cast<double>(cy + radius))) + 1, yMax);
+        const double r2 = static_cast<double>(radius) * static_cast<double>(radius);
+
+        for (int y = top; y < bottom; y++) {
+            const double dy = y + 0.5 - static_cast<double>(cy);
+            const double h2 = r2 - dy * dy;
+            if (h2 < 0) continue;
+            const double half = std::sqrt(h2);
+            const int x0 = std::max(static_cast<int>(std::lround(static_cast<double>(cx) - half)), 0);
+            const int x1 = std::min(static_cast<int>(std::lround(static_cast<double>(cx) + half)), fb.width);
+            if (x0 < x1) FillSpan(fb.Row(y), x0, x1, color);
+        }
+    }
+
+    // Where the row through py crosses the capsule of the given radius around [a, b], as [lo, hi) in x.
+    // The capsule is convex, so the row meets it in one interval: the hull of what the two end caps and the band
+    // between them cut from the row. Returns false if the row misses it.
+    [[nodiscard]] inline bool CapsuleSpan(const double ax, const double ay, const double bx, const double by,
+                                          const double radius, const double py, double& lo, double& hi) noexcept {
+        lo = INFINITY;
+        hi = -INFINITY;
+        auto cap = [&](const double cx, const double cy) {
+            const double dy = py - cy, h2 = radius * radius - dy * dy;
+            if (h2 < 0) return;
+            const double half = std::sqrt(h2);
+            lo = std::min(lo, cx - half);
+            hi = std::max(hi, cx + half);
+        };
+        cap(ax, ay);
+        cap(bx, by);
+
+        // The band: 0 <= (p - a).d <= |d|^2 and |d x (p - a)| <= radius |d|, each linear in x along the row
+        const double dx = bx - ax, dy = by - ay, lengthSquared = dx * dx + dy * dy;
+        if (lengthSquared > 0) {
+            double bandLo = -INFINITY, bandHi = INFINITY;
+            bool missed = false;
+            // Keeps the x where k x + c lies in [min, max]
+            auto clip = [&](const double k, const double c, const double min, const double max) {
+                if (k == 0) {
+                    missed |= c < min || c > max;
+                    return;
+                }
+                const double x0 = (min - c) / k, x1 = (max - c) / k;
+                bandLo = std::max(bandLo, std::min(x0, x1));
+                bandHi = std::min(bandHi, std::max(x0, x1));
+            };
+            const double rise = py - ay;
+            clip(dx, dy * rise - dx * ax, 0, lengthSquared);
+            const double reach = radius * std::sqrt(lengthSquared);
+            clip(-dy, dx * rise + dy * ax, -reach, reach);
+            if (!missed && bandLo <= bandHi) {
+                lo = std::min(lo, bandLo);
+                hi = std::max(hi, bandHi);
+            }
+        }
+        return lo <= hi;
+    }
+
+    // Capsule of half width radius around [a, b], clipped like FillCircle. Walls thinner than a pixel still
+    // cover one pixel per row they cross.
+    template<typename T>
+    void FillCapsule(Framebuffer& fb, const HuyNVector::Vector2<T>& a, const HuyNVector::Vector2<T>& b, const T radius,
+                     const std::uint32_t color, const int yMin, const int yMax) noexcept {
+        const double r = std::max(static_cast<double>(radius), 0.5);
+        const double ax = static_cast<double>(a.x), ay = static_cast<double>(a.y);
+        const double bx = static_cast<double>(b.x), by = static_cast<double>(b.y);
+        const int top = std::max(static_cast<int>(std::floor(std::min(ay, by) - r)), yMin);
+        const int bottom = std::min(static_cast<int>(std::ceil(std::max(ay, by) + r)) + 1, yMax);
+
+        for (int y = top; y < bottom; y++) {
+            double lo, hi;
+            if (!CapsuleSpan(ax, ay, bx, by, r, y + 0.5, lo, hi)) continue;
+            const long left = std::lround(lo);
+            const long right = std::max(std::lround(hi), left + 1);
+            const int x0 = static_cast<int>(std::max(left, 0L));
+            const int x1 = static_cast<int>(std::min(right, static_cast<long>(fb.width)));
+            if (x0 < x1) FillSpan(fb.Row(y), x0, x1, color);
+        }
+    }
+
+    // Bresenham, clipped to the frame and to the rows [yMin, yMax)
+    inline void DrawLine(Framebuffer& fb, int x0, int y0, const int x1, const int y1, const std::uint32_t color,
+                         const int yMin, const int yMax) noexcept {
+        const int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+        const int dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+        int err = dx + dy;
+        while (true) {
+            if (x0 >= 0 && x0 < fb.width && y0 >= yMin && y0 < yMax) fb.Row(y0)[x0] = color;
+            if (x0 == x1 && y0 == y1) break;
+            const int e2 = 2 * err;
+            if (e2 >= dy) { err += dy; x0 += sx; }
+            if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+    }
+
+
+    // *********************************** SOFTWARE RASTERIZER *********************************** //
+
+    // Draws a RenderSnapshot the same way the SDL window does (white bodies, hatched floor on black),
+    // without SDL, a display or a GPU. The frame is cut into horizontal bands; items are binned into the bands
+    // they touch and the bands are filled in parallel, so no two threads ever write the same pixel.
+    class SoftwareRasterizer {
+    public:
+        int bandHeight;
+        std::uint32_t background = PackRGBA(0x00, 0x00, 0x00);
+        std::uint32_t foreground = PackRGBA(0xFF, 0xFF, 0xFF);
+
+        explicit SoftwareRasterizer(const int bandHeight_ = 32) : bandHeight(bandHeight_) {}
+
+        template<typename T>
+        void Draw(Framebuffer& fb, const HuyNPhysic::RenderSnapshot<T>& snapshot, HuyNPhysic::ThreadPool* pool = nullptr) {
+            const int bandCount = (fb.height + bandHeight - 1) / bandHeight;
+            Bin(snapshot, bandCount, fb.height);
+
+            auto drawBand = [&](const std::size_t band) {
+                const int yMin = static_cast<int>(band) * bandHeight;
+                const int yMax = std::min(yMin + bandHeight, fb.height);
+
+                for (int y = yMin; y < yMax; y++) FillSpan(fb.Row(y), 0, fb.width, background);
+                DrawFloor(fb, static_cast<int>(snapshot.floor), yMin, yMax);
+                for (const std::uint32_t index : wallBins[band]) {
+                    const auto& wall = snapshot.walls[index];
+                    FillCapsule(fb, wall.a, wall.b, wall.thickness, foreground, yMin, yMax);
+                }
+
+                for (const std::uint32_t index : bins[band]) {
+                    const auto& item = snapshot.items[index];
+                    if (item.type == 'c') {
+                        FillCircle(fb, item.x, item.y, item.width, foreground, yMin, yMax);
+                    } else if (item.type == 'b') {
+                        // Truncate like the SDL path, so both outputs match pixel for pixel
+                        const int left = static_cast<int>(item.x - item.width / 2);
+                        const int top = static_cast<int>(item.y - item.height / 2);
+                        FillRect(fb, left, top, left + static_cast<int>(item.width), top + static_cast<int>(item.height),
+                                 foreground, yMin, yMax);
+                    }
+                }
+            };
+
+            if (pool) pool->ParallelFor(static_cast<std::size_t>(bandCount), drawBand);
+            else for (int band = 0; band < bandCount; band++) drawBand(static_cast<std::size_t>(band));
+        }
+
+    private:
+        std::vector<std::vector<std::uint32_t>> bins;
+        std::vector<std::vector<std::uint32_t>> wallBins;
+
+        void Insert(std::vector<std::vector<std::uint32_t>>& into, const std::size_t index, int top, int bottom,
+                    const int height) const {
+            top = std::max(top, 0);
+            bottom = std::min(bottom, height - 1);
+            if (top > bottom) return;
+            for (int band = top / bandHeight; band <= bottom / bandHeight; band++) {
+                into[band].push_back(static_cast<std::uint32_t>(index));
+            }
+        }
+
+        template<typename T>
+        void Bin(const HuyNPhysic::RenderSnapshot<T>& snapshot, const int bandCount, const int height) {
+            bins.resize(static_cast<std::size_t>(bandCount));
+            wallBins.resize(static_cast<std::size_t>(bandCount));
+            for (auto& b : bins) b.clear();
+            for (auto& b : wallBins) b.clear();
+
+            for (std::size_t i = 0; i < snapshot.items.size(); i++) {
+                const auto& item = snapshot.items[i];
+                const T halfHeight = item.type == 'c' ? item.width : item.height / 2;
+                Insert(bins, i, static_cast<int>(std::floor(static_cast<double>(item.y - halfHeight))),
+                       static_cast<int>(std::ceil(static_cast<double>(item.y + halfHeight))), height);
+            }
+            for (std::size_t i = 0; i < snapshot.walls.size(); i++) {
+                const auto& wall = snapshot.walls[i];
+                const double reach = std::max(static_cast<double>(wall.thickness), 0.5);
+                Insert(wallBins, i, static_cast<int>(std::floor(static_cast<double>(std::min(wall.a.y, wall.b.y)) - reach)),
+                       static_cast<int>(std::ceil(static_cast<double>(std::max(wall.a.y, wall.b.y)) + reach)), height);
+            }
+        }
+
+        void DrawFloor(Framebuffer& fb, const int floor, const int yMin, const int yMax) const {
+            if (floor >= yMin && floor < yMax) FillSpan(fb.Row(floor), 0, fb.width, foreground);
+            if (floor + 10 < yMin || floor >= yMax) return;
+            for (int x = 0; x + 5 < fb.width; x += 10) DrawLine(fb, x, floor, x + 5, floor + 10, foreground, yMin, yMax);
+        }
+    };
+
+}
+
+#endif //SOFTWARERASTERIZER_H
@@ -95,6 +95,9 @@ namespace Shape {
 
         // ******************************** BUILT-IN DRAW FUNCTIONS ******************************** //
 
+        // Only available when SDL.h is included first; headless builds use Render/SoftwareRasterizer.h
+#ifdef SDL_h_
+
         constexpr void SDL_DrawBox(SDL_Renderer *renderer) const noexcept {
             const SDL_Rect box{static_cast<int>(this->x), static_cast<int>(this->y), static_cast<int>(this.width), static_cast<int>(this.height)};
             SDL_RenderDrawRect(renderer, &box);
@@ -104,6 +107,7 @@ namespace Shape {
             const SDL_Rect box{static_cast<int>(this->x), static_cast<int>(this->y), static_cast<int>(this->width), static_cast<int>(this->height)};
             SDL_RenderFillRect(renderer, &box);
         }
+#endif
 
     };
 }
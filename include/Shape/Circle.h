@@ -47,7 +47,7 @@ namespace Shape {
         }
 
         [[nodiscard]] T area() const override {
-            return M_PI * this->radius * this->radius;
+            return static_cast<T>(M_PI) * this->radius * this->radius;
         }
 
         [[nodiscard]] bool contains(Vector2<T> position) const override {
@@ -71,6 +71,9 @@ namespace Shape {
 
         // ******************************** BUILT-IN DRAW FUNCTIONS ******************************** //
 
+        // Only available when SDL.h is included first; headless builds use Render/SoftwareRasterizer.h
+#ifdef SDL_h_
+
         constexpr int SDL_DrawCircle(SDL_Renderer *renderer) {
             return SDL_RenderDrawCircle(renderer, this->x, this->y, this.radius);
         };
@@ -78,9 +81,12 @@ namespace Shape {
         constexpr int SDL_FillCircle(SDL_Renderer *renderer) {
             return SDL_RenderFillCircle(renderer, this->x, this->y, this.radius);
         }
+#endif
 
     };
 
+#ifdef SDL_h_
+
     constexpr int SDL_RenderDrawCircle(SDL_Renderer *renderer,const int x,const int y,const int radius) {
         int offsetX = 0;
         int offsetY = radius;
@@ -146,6 +152,7 @@ namespace Shape {
         }
         return status;
     };
+#endif
 
 }
 
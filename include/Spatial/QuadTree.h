@@ -3,6 +3,8 @@
 //
 #pragma once
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "Vector2.h"
@@ -24,11 +26,46 @@ namespace QuadTree {
         bool divided;
 
         std::vector<Vector2<T>> points{};
+        std::vector<std::uint32_t> items{};    // caller's handle for each point, e.g. a body index
 
         QuadTree *child[4]{};
 
+        static constexpr int MaxDepth = 16;     // coincident points stop splitting here
+
         constexpr explicit QuadTree(Shape::Box<T> _boundary, const int _capacity = 4) : capacity(_capacity), boundary(_boundary), divided(false) {}
 
+        // Nodes own their children
+        QuadTree(const QuadTree &other) : capacity(other.capacity), boundary(other.boundary), divided(other.divided),
+                                          points(other.points), items(other.items), depth(other.depth) {
+            if (divided) {
+                for (int i = 0; i < 4; i++) child[i] = new QuadTree(*other.child[i]);
+            }
+        }
+
+        QuadTree(QuadTree &&other) noexcept : capacity(other.capacity), boundary(other.boundary), divided(other.divided),
+                                              points(std::move(other.points)), items(std::move(other.items)), depth(other.depth) {
+            for (int i = 0; i < 4; i++) {
+                child[i] = other.child[i];
+                other.child[i] = nullptr;
+            }
+            other.divided = false;
+        }
+
+        QuadTree &operator=(QuadTree other) noexcept {
+            std::swap(capacity, other.capacity);
+            std::swap(boundary, other.boundary);
+            std::swap(divided, other.divided);
+            points.swap(other.points);
+            items.swap(other.items);
+            std::swap(child, other.child);
+            std::swap(depth, other.depth);
+            return *this;
+        }
+
+        ~QuadTree() {
+            clear();
+        }
+
         // ********************************* QUADTREE FUNCTIONS ******************************** //
 
         [[nodiscard]] constexpr QuadTree *getChild(Vector2<T> _pos) {
@@ -64,19 +101,20 @@ namespace QuadTree {
             return &boundary;
         }
 
-        [[nodiscard]] constexpr bool insert(const Vector2<T> _p) {
+        [[nodiscard]] constexpr bool insert(const Vector2<T> _p, const std::uint32_t _item = 0) {
             if (!boundary.contains(_p)) return false;
             if (!divided) {
-                if (points.size() < capacity) {
+                if (points.size() < capacity || depth >= MaxDepth) {
                     points.push_back(_p);
+                    items.push_back(_item);
                     return true;
                 }
                 this->subdivide();
             }
-            return (child[0]->insert(_p) ||
-                    child[1]->insert(_p) ||
-                    child[2]->insert(_p) ||
-                    child[3]->insert(_p)
+            return (child[0]->insert(_p, _item) ||
+                    child[1]->insert(_p, _item) ||
+                    child[2]->insert(_p, _item) ||
+                    child[3]->insert(_p, _item)
                     );
         }
 
@@ -85,33 +123,78 @@ namespace QuadTree {
             child[1] = new QuadTree(boundary.subdivide("nw"), capacity);
             child[2] = new QuadTree(boundary.subdivide("se"), capacity);
             child[3] = new QuadTree(boundary.subdivide("sw"), capacity);
+            for (auto &c : child) c->depth = depth + 1;
 
             divided = true;
 
             // Move points to children
-            for (const auto &p : points) {
-                const bool inserted =   child[0]->insert(p) ||
-                                        child[1]->insert(p) ||
-                                        child[2]->insert(p) ||
-                                        child[3]->insert(p);
+            for (std::size_t i = 0; i < points.size(); i++) {
+                const bool inserted =   child[0]->insert(points[i], items[i]) ||
+                                        child[1]->insert(points[i], items[i]) ||
+                                        child[2]->insert(points[i], items[i]) ||
+                                        child[3]->insert(points[i], items[i]);
 
                 if (!inserted) {
                     return false;
                 }
             }
             points.clear();
+            items.clear();
             return true;
         }
 
+        // Calls visit(point, item) for every point inside the range
+        template<typename Visit>
+        void query(const Shape::Box<T> &range, Visit &&visit) const {
+            if (!boundary.intersects(range) && !boundary.contains(range.x, range.y)) return;
+            if (divided) {
+                for (const auto &c : child) c->query(range, visit);
+                return;
+            }
+            for (std::size_t i = 0; i < points.size(); i++) {
+                if (range.contains(points[i])) visit(points[i], items[i]);
+            }
+        }
+
+        // Drops every point but keeps the nodes and their storage, so rebuilding a tree of similar shape
+        // every step does not allocate
+        void reset() {
+            if (divided) {
+                for (auto &c : child) c->reset();
+            }
+            points.clear();
+            items.clear();
+        }
+
+        // Drops every point and child node, keeping the boundary
+        void clear() {
+            if (divided) {
+                for (auto &c : child) {
+                    delete c;
+                    c = nullptr;
+                }
+                divided = false;
+            }
+            points.clear();
+            items.clear();
+        }
+
 
         // ********************************* BUILT-IN QUADTREE DRAW FUNCTION ******************************** //
 
+        // Only available when SDL.h is included first
+#ifdef SDL_h_
+
         constexpr void SDL_DrawTree(SDL_Renderer *renderer) {
             if (this->divided) {
                 for (auto & c : this->child) c->SDL_DrawTree(renderer);
             }
             this->boundary.SDL_DrawBox(renderer);
         }
+#endif
+
+    private:
+        int depth = 0;
 
     };
 }
@@ -0,0 +1,192 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "Vector2.h"
+
+#ifndef STATICBVH_H
+#define STATICBVH_H
+
+using HuyNVector::Vector2;
+
+namespace Spatial {
+
+    template<typename T>
+    struct WallSegment {
+        Vector2<T> a;
+        Vector2<T> b;
+        T thickness;                    // half width: the wall is the capsule around [a, b]
+
+        [[nodiscard]] Vector2<T> ClosestPoint(const Vector2<T>& p) const {
+            const Vector2<T> ab = b - a;
+            const T lengthSquared = ab.dot(ab);
+            if (lengthSquared == 0) return a;
+            const T t = std::clamp((p - a).dot(ab) / lengthSquared, T(0), T(1));
+            return a + ab * t;
+        }
+    };
+
+    template<typename T>
+    struct AABB {
+        T minX, minY, maxX, maxY;
+
+        [[nodiscard]] constexpr bool overlaps(const AABB& other) const noexcept {
+            return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+        }
+    };
+
+
+    // **************************************** STATIC BVH **************************************** //
+
+    // Bounding volume hierarchy over static wall segments.
+    // Walls never move, so the tree is built once and rebuilt only after an edit; dynamic bodies query it each
+    // tick and static-vs-static pairs are never considered. Nodes are stored flat, children of a node are
+    // contiguous, and leaves reference a range of the reordered segment list.
+    template<typename T>
+    class StaticBVH {
+    public:
+        static constexpr int LeafSize = 4;
+        // Query walks the tree with a fixed stack holding at most one pending sibling per level plus the root.
+        // Median splits halve the count at every level, so a tree over 32-bit counts is at most 32 levels deep.
+        static constexpr int QueryStackSize = 64;
+        static_assert(QueryStackSize >= 32 + 2, "room for one sibling per level of a 32-level tree");
+
+        struct Node {
+            AABB<T> bounds;
+            std::uint32_t first;        // leaf: first index into order; inner: index of the left child
+            std::uint32_t count;        // leaf: number of segments; inner: 0
+        };
+
+        void AddSegment(const Vector2<T>& a, const Vector2<T>& b, const T thickness = 2) {
+            segments.push_back(WallSegment<T>{a, b, thickness});
+            Invalidate();
+        }
+
+        // Outline of a polygon as segments; closed joins the last point back to the first
+        void AddPolygon(const std::vector<Vector2<T>>& points, const T thickness = 2, const bool closed = true) {
+            if (points.size() < 2) return;
+            for (std::size_t i = 0; i + 1 < points.size(); i++) segments.push_back(WallSegment<T>{points[i], points[i + 1], thickness});
+            if (closed && points.size() > 2) segments.push_back(WallSegment<T>{points.back(), points.front(), thickness});
+            Invalidate();
+        }
+
+        void Clear() {
+            segments.clear();
+            Invalidate();
+        }
+
+        [[nodiscard]] const std::vector<WallSegment<T>>& Segments() const noexcept { return segments; }
+        [[nodiscard]] bool Empty() const noexcept { return segments.empty(); }
+
+        // Bumped on every edit, so observers (renderers) can tell when to recopy the walls
+        [[nodiscard]] std::uint64_t Version() const noexcept { return version; }
+
+        // Rebuilds only if the walls changed since the last build
+        void Update() {
+            if (dirty) Build();
+        }
+
+        void Build() {
+            nodes.clear();
+            order.resize(segments.size());
+            boxes.resize(segments.size());
+            for (std::uint32_t i = 0; i < segments.size(); i++) {
+                order[i] = i;
+                boxes[i] = Bounds(segments[i]);
+            }
+            if (!segments.empty()) {
+                nodes.reserve(2 * segments.size() / LeafSize + 1);
+                nodes.push_back(Node{});
+                BuildNode(0, 0, static_cast<std::uint32_t>(segments.size()));
+            }
+            dirty = false;
+        }
+
+        // Calls visit(segment) for every wall whose bounds overlap the box. The tree must be up to date.
+        template<typename Visit>
+        void Query(const AABB<T>& box, Visit&& visit) const {
+            if (nodes.empty()) return;
+
+            std::uint32_t stack[QueryStackSize];
+            int top = 0;
+            stack[top++] = 0;
+            while (top > 0) {
+                const Node& node = nodes[stack[--top]];
+                if (!node.bounds.overlaps(box)) continue;
+                if (node.count > 0) {
+                    for (std::uint32_t i = node.first; i < node.first + node.count; i++) {
+                        if (boxes[order[i]].overlaps(box)) visit(segments[order[i]]);
+                    }
+                } else {
+                    assert(top + 2 <= QueryStackSize);
+                    stack[top++] = node.first;
+                    stack[top++] = node.first + 1;
+                }
+            }
+        }
+
+    private:
+        std::vector<WallSegment<T>> segments;
+        std::vector<AABB<T>> boxes;
+        std::vector<std::uint32_t> order;
+        std::vector<Node> nodes;
+        std::uint64_t version = 0;
+        bool dirty = false;
+
+        void Invalidate() {
+            dirty = true;
+            ++version;
+        }
+
+        static AABB<T> Bounds(const WallSegment<T>& s) {
+            return AABB<T>{std::min(s.a.x, s.b.x) - s.thickness, std::min(s.a.y, s.b.y) - s.thickness,
+                           std::max(s.a.x, s.b.x) + s.thickness, std::max(s.a.y, s.b.y) + s.thickness};
+        }
+
+        // Median split on the longest axis of the centroid bounds; depth stays ~log2(n / LeafSize)
+        void BuildNode(const std::uint32_t index, const std::uint32_t first, const std::uint32_t count) {
+            AABB<T> bounds = boxes[order[first]];
+            AABB<T> centroids{bounds.maxX, bounds.maxY, bounds.minX, bounds.minY};
+            for (std::uint32_t i = first; i < first + count; i++) {
+                const AABB<T>& b = boxes[order[i]];
+                bounds = AABB<T>{std::min(bounds.minX, b.minX), std::min(bounds.minY, b.minY),
+                                 std::max(bounds.maxX, b.maxX), std::max(bounds.maxY, b.maxY)};
+                const T cx = (b.minX + b.maxX) / 2, cy = (b.minY + b.maxY) / 2;
+                centroids = AABB<T>{std::min(centroids.minX, cx), std::min(centroids.minY, cy),
+                                    std::max(centroids.maxX, cx), std::max(centroids.maxY, cy)};
+            }
+            nodes[index].bounds = bounds;
+
+            if (count <= LeafSize) {
+                nodes[index].first = first;
+                nodes[index].count = count;
+                return;
+            }
+
+            const bool splitX = centroids.maxX - centroids.minX >= centroids.maxY - centroids.minY;
+            const std::uint32_t half = count / 2;
+            std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                             [&](const std::uint32_t l, const std::uint32_t r) {
+                                 return splitX ? boxes[l].minX + boxes[l].maxX < boxes[r].minX + boxes[r].maxX
+                                               : boxes[l].minY + boxes[l].maxY < boxes[r].minY + boxes[r].maxY;
+                             });
+
+            const auto left = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back(Node{});
+            nodes.push_back(Node{});
+            nodes[index].first = left;
+            nodes[index].count = 0;
+            BuildNode(left, first, half);
+            BuildNode(left + 1, first + half, count - half);
+        }
+    };
+
+}
+
+#endif //STATICBVH_H
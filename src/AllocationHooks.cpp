@@ -0,0 +1,88 @@
+// RULE: 1px = 1cm irl
+
+// Global operator new / delete that report to AllocationTracker.h.
+// Linked into the executables only when configured with PHYSIC_TRACK_ALLOCATIONS=ON.
+
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "AllocationTracker.h"
+
+#ifdef HUYN_PHYSIC_TRACK_ALLOCATIONS
+
+namespace {
+
+    void* Allocate(const std::size_t size) noexcept {
+        HuyNPhysic::AllocationTracking::Record(size);
+        return std::malloc(size ? size : 1);
+    }
+
+    void* AllocateAligned(const std::size_t size, const std::align_val_t alignment) noexcept {
+        HuyNPhysic::AllocationTracking::Record(size);
+        const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size ? size : 1, align);
+#else
+        // aligned_alloc wants the size to be a multiple of the alignment
+        return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+    }
+
+    void FreeAligned(void* p) noexcept {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+}
+
+void* operator new(const std::size_t size) {
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) {
+    if (void* p = Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+    if (void* p = AllocateAligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+    if (void* p = AllocateAligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { FreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(p); }
+
+#endif
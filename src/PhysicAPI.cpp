@@ -0,0 +1,149 @@
+
+// RULE: 1px = 1cm irl
+
+// huyn_physic: the C interface in PhysicAPI.h over World<Real>.
+// No exception crosses the boundary; allocation failures surface as NULL or short counts.
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+#include "PhysicAPI.h"
+#include "Precision.h"
+#include "World.h"
+
+using namespace HuyNPhysic;
+
+#ifdef HUYN_PHYSIC_PRECISION_FIXED
+static_assert(std::is_same_v<Real, Fixed>, "PhysicAPI.h and Precision.h disagree on the scalar type");
+static Real FromAPI(const HuyNPhysic_Real value) { return Fixed::FromRaw(value); }
+static HuyNPhysic_Real ToAPI(const Real value) { return value.raw; }
+#else
+static_assert(std::is_same_v<HuyNPhysic_Real, Real>, "PhysicAPI.h and Precision.h disagree on the scalar type");
+static Real FromAPI(const HuyNPhysic_Real value) { return value; }
+static HuyNPhysic_Real ToAPI(const Real value) { return value; }
+#endif
+
+struct HuyNPhysic_World {
+    World<Real> world;
+};
+
+namespace {
+
+    template<typename MakeShape>
+    size_t AddBodies(HuyNPhysic_World* handle, const size_t count, const HuyNPhysic_Real* positions,
+                     const HuyNPhysic_Real* velocities, const HuyNPhysic_Real* masses, uint32_t* ids,
+                     MakeShape&& makeShape) {
+        World<Real>& world = handle->world;
+        const size_t before = world.objects.size();
+        try {
+            // Grow geometrically, so many small adds stay linear overall
+            const size_t needed = world.objects.size() + count;
+            if (world.objects.capacity() < needed) world.Reserve(std::max(needed, 2 * world.objects.capacity()));
+            for (size_t i = 0; i < count; i++) {
+                const Real x = FromAPI(positions[2 * i]), y = FromAPI(positions[2 * i + 1]);
+                const Real vx = velocities ? FromAPI(velocities[2 * i]) : 0;
+                const Real vy = velocities ? FromAPI(velocities[2 * i + 1]) : 0;
+                auto shape = makeShape(i, x, y);
+                const uint32_t id = world.AddBody(Object<Real>{x, y, FromAPI(masses[i]), &shape, vx, vy});
+                if (ids) ids[i] = id;
+            }
+        } catch (const std::bad_alloc&) {
+            return world.objects.size() - before;
+        }
+        return count;
+    }
+
+}
+
+extern "C" {
+
+HuyNPhysic_Precision HuyNPhysic_GetPrecision(void) {
+    return HUYN_PHYSIC_HEADER_PRECISION;
+}
+
+size_t HuyNPhysic_RealSize(void) {
+    return sizeof(HuyNPhysic_Real);
+}
+
+HuyNPhysic_World* HuyNPhysic_CreateWorld(const HuyNPhysic_Real width, const HuyNPhysic_Real height,
+                                         const HuyNPhysic_Real floorOffset) {
+    return new (std::nothrow) HuyNPhysic_World{World<Real>{FromAPI(width), FromAPI(height), FromAPI(floorOffset)}};
+}
+
+void HuyNPhysic_DestroyWorld(HuyNPhysic_World* world) {
+    delete world;
+}
+
+void HuyNPhysic_Reserve(HuyNPhysic_World* world, const size_t bodies) {
+    try {
+        world->world.Reserve(bodies);
+    } catch (const std::bad_alloc&) {}
+}
+
+void HuyNPhysic_SetGravity(HuyNPhysic_World* world, const HuyNPhysic_Real x, const HuyNPhysic_Real y) {
+    world->world.gravity = Vector2<Real>{FromAPI(x), FromAPI(y)};
+}
+
+void HuyNPhysic_SetTickInterval(HuyNPhysic_World* world, const uint64_t milliseconds) {
+    world->world.tickInterval = milliseconds;
+}
+
+size_t HuyNPhysic_AddCircles(HuyNPhysic_World* world, const size_t count, const HuyNPhysic_Real* positions,
+                             const HuyNPhysic_Real* velocities, const HuyNPhysic_Real* radii,
+                             const HuyNPhysic_Real* masses, uint32_t* ids) {
+    return AddBodies(world, count, positions, velocities, masses, ids, [&](const size_t i, const Real x, const Real y) {
+        return Shape::Circle<Real>{Vector2<Real>{x, y}, FromAPI(radii[i])};
+    });
+}
+
+size_t HuyNPhysic_AddBoxes(HuyNPhysic_World* world, const size_t count, const HuyNPhysic_Real* positions,
+                           const HuyNPhysic_Real* velocities, const HuyNPhysic_Real* sizes,
+                           const HuyNPhysic_Real* masses, uint32_t* ids) {
+    return AddBodies(world, count, positions, velocities, masses, ids, [&](const size_t i, const Real x, const Real y) {
+        return Shape::Box<Real>{Vector2<Real>{x, y}, FromAPI(sizes[2 * i]), FromAPI(sizes[2 * i + 1])};
+    });
+}
+
+size_t HuyNPhysic_RemoveBodies(HuyNPhysic_World* world, const size_t count, const uint32_t* ids) {
+    size_t removed = 0;
+    for (size_t i = 0; i < count; i++) removed += world->world.RemoveBody(ids[i]);
+    return removed;
+}
+
+uint64_t HuyNPhysic_Step(HuyNPhysic_World* world, const uint64_t ticks) {
+    uint64_t t = 0;
+    try {
+        for (; t < ticks; t++) world->world.Step();
+    } catch (...) {}
+    return t;
+}
+
+size_t HuyNPhysic_BodyCount(const HuyNPhysic_World* world) {
+    return world->world.objects.size();
+}
+
+uint64_t HuyNPhysic_Tick(const HuyNPhysic_World* world) {
+    return world->world.tick;
+}
+
+size_t HuyNPhysic_ReadState(const HuyNPhysic_World* world, const size_t capacity, uint32_t* ids,
+                            HuyNPhysic_Real* positions, HuyNPhysic_Real* velocities) {
+    const auto& objects = world->world.objects;
+    const size_t count = std::min(capacity, objects.size());
+    for (size_t i = 0; i < count; i++) {
+        const Object<Real>& o = objects[i];
+        if (ids) ids[i] = o.id;
+        if (positions) {
+            positions[2 * i] = ToAPI(o.x);
+            positions[2 * i + 1] = ToAPI(o.y);
+        }
+        if (velocities) {
+            velocities[2 * i] = ToAPI(o.velocity.x);
+            velocities[2 * i + 1] = ToAPI(o.velocity.y);
+        }
+    }
+    return count;
+}
+
+}
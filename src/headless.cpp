@@ -0,0 +1,207 @@
+
+// RULE: 1px = 1cm irl
+
+// Headless runner: steps a sandbox world without SDL and renders frames in software.
+//
+//   physicHeadless [--gravity=none|pairs|mesh|p3m] <ticks> <output> [ppm|png|raw] [frameEvery] [bodies] [seed] [diagnostics.csv]
+//
+// --gravity picks how bodies attract each other: not at all (the default), pairs sums every pair directly,
+// mesh uses particle-mesh gravity and p3m adds its short-range correction. All but none need a floating-point build.
+// ppm / png write <output>_000000.<ext>, <output>_000001.<ext>, ...
+// raw writes one RGBA stream to <output> ("-" for stdout), ready for ffmpeg -f rawvideo.
+// diagnostics.csv, if given, receives one row of conservation values per step.
+// Built with PHYSIC_TRACK_ALLOCATIONS, it also records every step into a rewind buffer as the sandbox does,
+// reports heap allocations per phase and fails if any step after the warm-up allocated.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Precision.h"
+#include "AllocationTracker.h"
+#include "World.h"
+#include "ParticleMesh.h"
+#include "RewindBuffer.h"
+#include "StateBuffer.h"
+#include "ThreadPool.h"
+#include "SoftwareRasterizer.h"
+#include "FrameWriter.h"
+
+using namespace HuyNPhysic;
+
+constexpr int FrameWidth = 1360,
+              FrameHeight = 765;
+
+// Steps after this many must not allocate: by then every buffer has grown to the scene
+constexpr unsigned long long AllocationWarmupTicks = 100;
+constexpr std::size_t RewindTicks = 64;         // fills up within the warm-up
+
+static void PrintAllocations(const char* title, const AllocationStats& stats) {
+    std::fprintf(stderr, "%s\n", title);
+    for (std::size_t i = 0; i < AllocationPhaseCount; i++) {
+        const auto phase = static_cast<AllocationPhase>(i);
+        std::fprintf(stderr, "  %-12s %10llu allocations %12llu bytes\n", AllocationPhaseName(phase),
+                     static_cast<unsigned long long>(stats[phase].allocations),
+                     static_cast<unsigned long long>(stats[phase].bytes));
+    }
+}
+
+struct Options {
+    unsigned long long ticks;
+    std::string output;
+    std::string format;
+    unsigned long long frameEvery;
+    std::size_t bodies;
+    unsigned long long seed;
+    std::string diagnosticsPath;
+};
+
+template<typename Forces>
+static int Run(const Options& options, ThreadPool& pool, Forces forces) {
+    World<Real, Integrator::VelocityVerlet, Forces> world{FrameWidth, FrameHeight};
+    world.forces = std::move(forces);
+    world.Reserve(options.bodies);
+    SpawnSettings<Real> spawn{0, 0, world.width, world.Floor(), options.bodies, 10, 40};
+    spawn.maxSpeed = 500;
+    spawn.seed = options.seed;
+    world.Spawn(spawn);
+
+    std::ofstream diagnostics;
+    if (!options.diagnosticsPath.empty()) {
+        diagnostics.open(options.diagnosticsPath);
+        if (!diagnostics) {
+            std::fprintf(stderr, "cannot open '%s'\n", options.diagnosticsPath.c_str());
+            return EXIT_FAILURE;
+        }
+        WriteDiagnosticsHeader(diagnostics);
+        world.diagnostics.enabled = true;
+        world.diagnostics.pool = &pool;
+    }
+    Render::SoftwareRasterizer rasterizer;
+    Render::Framebuffer frame{FrameWidth, FrameHeight};
+    RenderSnapshot<Real> snapshot;
+
+    const std::string& output = options.output;
+    const std::string& format = options.format;
+    std::optional<Render::RawVideoWriter> video;
+    if (format == "raw" && !video.emplace(output).IsOpen()) {
+        std::fprintf(stderr, "cannot open '%s'\n", output.c_str());
+        return EXIT_FAILURE;
+    }
+
+    RewindBuffer<Real> rewind{RewindTicks};
+
+    AllocationStats allocations, steadyAllocations;
+    unsigned long long allocatingSteps = 0;
+    // Counts what fn allocates; steady-state allocations are the ones the check fails on
+    auto track = [&](const unsigned long long t, auto&& fn) {
+        const AllocationStats before = AllocationTracking::Read();
+        fn();
+        const AllocationStats step = AllocationTracking::Read() - before;
+        allocations += step;
+        if (t > AllocationWarmupTicks && step.Total().allocations > 0) {
+            steadyAllocations += step;
+            allocatingSteps++;
+        }
+    };
+
+    unsigned long long frameIndex = 0;
+    for (unsigned long long t = 0; t <= options.ticks; t++) {
+        if (t > 0) {
+            track(t, [&] {
+                world.Step();
+                if constexpr (AllocationTrackingEnabled) rewind.Record(world);
+            });
+            if (world.diagnostics.enabled) WriteDiagnosticsRow(diagnostics, world.diagnostics.last);
+        }
+        if (t % options.frameEvery != 0) continue;
+
+        track(t, [&] { CaptureSnapshot(world, snapshot); });
+        rasterizer.Draw(frame, snapshot, &pool);
+
+        bool written;
+        if (format == "raw") {
+            written = video->Write(frame);
+        } else {
+            char name[32];
+            std::snprintf(name, sizeof(name), "_%06llu.", frameIndex);
+            const std::string path = output + name + format;
+            written = format == "png" ? Render::WritePNG(path, frame) : Render::WritePPM(path, frame);
+        }
+        if (!written) {
+            std::fprintf(stderr, "failed to write frame %llu\n", frameIndex);
+            return EXIT_FAILURE;
+        }
+        frameIndex++;
+    }
+
+    std::fprintf(stderr, "%llu ticks, %llu frames\n", options.ticks, frameIndex);
+
+    if constexpr (AllocationTrackingEnabled) {
+        PrintAllocations("allocations while stepping:", allocations);
+        if (allocatingSteps > 0) {
+            std::fprintf(stderr, "%llu steps after the first %llu allocated\n", allocatingSteps, AllocationWarmupTicks);
+            PrintAllocations("steady-state allocations:", steadyAllocations);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+// Gravity between bodies; accelerations that small are far below what a fixed build can represent
+template<typename T>
+static int RunAttracting(const std::string& gravity, const Options& options, ThreadPool& pool) {
+    if constexpr (std::numeric_limits<T>::is_exact) {
+        std::fprintf(stderr, "--gravity=%s needs a floating-point build\n", gravity.c_str());
+        return EXIT_FAILURE;
+    } else {
+        if (gravity == "pairs") return Run(options, pool, PairwiseGravityForceField<T>{});
+        ParticleMeshForceField<T> forces;
+        auto& mesh = forces.template Get<ParticleMeshGravity<T>>();
+        mesh.pool = &pool;
+        if (gravity == "p3m") mesh.splitScale = 16;
+        return Run(options, pool, std::move(forces));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::string gravity = "none";
+    std::vector<char*> args;
+    for (int i = 0; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--gravity=", 0) == 0) gravity = arg.substr(10);
+        else args.push_back(argv[i]);
+    }
+    if (args.size() < 3) {
+        std::fprintf(stderr, "usage: %s [--gravity=none|pairs|mesh|p3m] <ticks> <output> [ppm|png|raw] [frameEvery] [bodies] [seed] [diagnostics.csv]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Options options;
+    options.ticks = std::strtoull(args[1], nullptr, 10);
+    options.output = args[2];
+    options.format = args.size() > 3 ? args[3] : "png";
+    options.frameEvery = args.size() > 4 ? std::max(1ULL, std::strtoull(args[4], nullptr, 10)) : 1;
+    options.bodies = args.size() > 5 ? std::strtoull(args[5], nullptr, 10) : 64;
+    options.seed = args.size() > 6 ? std::strtoull(args[6], nullptr, 10) : 0;
+    options.diagnosticsPath = args.size() > 7 ? args[7] : "";
+
+    if (options.format != "ppm" && options.format != "png" && options.format != "raw") {
+        std::fprintf(stderr, "unknown format '%s', expected ppm, png or raw\n", options.format.c_str());
+        return EXIT_FAILURE;
+    }
+
+    ThreadPool pool;
+    if (gravity == "none") return Run(options, pool, DefaultForceField<Real>{});
+    if (gravity != "pairs" && gravity != "mesh" && gravity != "p3m") {
+        std::fprintf(stderr, "unknown gravity '%s', expected none, pairs, mesh or p3m\n", gravity.c_str());
+        return EXIT_FAILURE;
+    }
+    return RunAttracting<Real>(gravity, options, pool);
+}
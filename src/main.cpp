@@ -3,13 +3,18 @@
 
 
 // TODO: add multiple more objects and process with quadtree
-// TODO: add mouse drawing wall
 
 #include <bits/stdc++.h>
 #include <SDL.h>
 #include "QuadTree.h"
 #include "Circle.h"
+#include "Precision.h"
 #include "PhysicEngine.h"
+#include "World.h"
+#include "StateBuffer.h"
+#include "CommandQueue.h"
+#include "RewindBuffer.h"
+#include "SoftwareRasterizer.h"
 
 using std::cout, std::cerr, std::endl, std::string, std::ceil, std::floor, std::vector, std::round, std::abs, std::sqrt, std::atan2, std::pow, std::sin, std::cos, std::acos, std::rand, std::queue, std::stack, HuyNVector::Vector2, std::get, std::move, std::visit, std::decay_t, std::is_same_v;
 
@@ -27,10 +32,6 @@ public:
 
 // GLOBAL VARIABLE
 
-uint64_t FrameUpdateInterval = 10, // ms
-         LatestUpdatedTick = 0,
-         CurrentTick;
-
 struct Size {
     int w;
     int h;
@@ -47,14 +48,35 @@ constexpr Size WindowMinSize{640, 480};
 double scaleFactor = 1.0; // Starting scale: 1 px = 1 cm
 Vector2 viewCenter{WindowSize.w / 2.0, WindowSize.h / 2.0}; // Center of the view
 
-QuadTree::QuadTree Q{Shape::Box<double>{10, 10, static_cast<double>(WindowSize.w - 20), static_cast<double>(WindowSize.h - 20)}};
+int iDistance_From_Bottom_To_Floor = 0;
+
+// Bodies, bounds, gravity and solver state; everything above only describes the window and view
+World<Real, Integrator::VelocityVerlet> Sandbox{static_cast<Real>(WindowSize.w), static_cast<Real>(WindowSize.h),
+                                                static_cast<Real>(iDistance_From_Bottom_To_Floor)};
 
+// Physics publishes a snapshot after every step; the render loop draws the newest completed one
+TripleBuffer<RenderSnapshot<Real>> FrameState;
+std::atomic<bool> PhysicsRunning{true};
 
-int iDistance_From_Bottom_To_Floor = 0,
-    iFloor = WindowSize.h - iDistance_From_Bottom_To_Floor;
+// Everything the user does reaches the physics thread through here and is applied between steps.
+// The SDL thread is the only producer: the resize watcher runs on it too, from inside SDL_PollEvent.
+CommandQueue<Real> InputCommands{4096};
 
+// Commands the ring had no room for. Only painted bodies may be lost, so everything else waits here, in order,
+// and is retried every frame before new input; painted bodies are dropped and counted instead.
+std::deque<Command<Real>> PendingCommands;
+uint64_t DroppedPaintCommands = 0;
 
-constexpr Vector2<double> Gravitational_Acceleration{0, 9.8};
+// --diagnostics [file.csv]: conservation values in the window title, and one CSV row per step if a file is given
+std::ofstream DiagnosticsCsv;
+
+// Input bindings
+constexpr Real PaintRadius = 10;                // right drag paints circles of this radius
+constexpr Real BodyDensity = static_cast<Real>(0.001);     // mass per px^2 of bodies added by hand
+constexpr Real SpawnSize = 40;                  // C / B drop a circle of this radius / a box of twice this side
+constexpr Real FlickImpulsePerPixel = 5;        // middle drag: impulse on the bodies under the press point
+constexpr uint64_t MaxTimestep = 50;            // ms; = and - step the timestep within [1, MaxTimestep]
+constexpr size_t RewindTicks = 1000;            // steps kept for scrubbing back with the arrow keys
 
 struct objectsProperties {
     double radius{};
@@ -66,76 +88,88 @@ struct objectsProperties {
     queue<Vector2<double>> Trail;
 };
 
-vector<Object<double>> objects;
-
 // FUNCTIONS
 
+// SDL thread only. Commands where only the newest matters replace a parked one of the same kind; scrubs add up.
+void SendCommand(const Command<Real>& command) {
+    if (PendingCommands.empty() && InputCommands.TryPush(command)) return;
+
+    if (!PendingCommands.empty() && PendingCommands.back().index() == command.index()) {
+        Command<Real>& parked = PendingCommands.back();
+        if (auto* scrub = std::get_if<Commands::Scrub>(&parked)) {
+            scrub->ticks += std::get<Commands::Scrub>(command).ticks;
+            return;
+        }
+        if (std::holds_alternative<Commands::SetPaused>(command) || std::holds_alternative<Commands::SetTimestep>(command) ||
+            std::holds_alternative<Commands::Resize>(command)) {
+            parked = command;
+            return;
+        }
+    }
+    PendingCommands.push_back(command);
+}
+
+void FlushPendingCommands() {
+    while (!PendingCommands.empty() && InputCommands.TryPush(PendingCommands.front())) PendingCommands.pop_front();
+}
+
 static int resizingEventWatcher(void* data, const SDL_Event* event) {
     if (event->type == SDL_WINDOWEVENT &&
         event->window.event == SDL_WINDOWEVENT_RESIZED) {
         if (const SDL_Window* win = SDL_GetWindowFromID(event->window.windowID); win == static_cast<SDL_Window *>(data)) {
             WindowSize.w = event->window.data1;
             WindowSize.h = event->window.data2;
-            iFloor = WindowSize.h - iDistance_From_Bottom_To_Floor;
+            SendCommand(Commands::Resize{static_cast<uint32_t>(WindowSize.w), static_cast<uint32_t>(WindowSize.h)});
         }
         }
     return 0;
 }
 
 
-void DrawObjects(SDL_Renderer *renderer) {
-    for (const auto& o : objects) {
-        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 255);
+void DrawObjects(SDL_Renderer *renderer, const RenderSnapshot<Real>& snapshot) {
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 255);
 
-        char shapeType = o.shape->getType();
-        if (shapeType == 'c') {
-            const auto* circle = dynamic_cast<Shape::Circle<double>*>(o.shape);
+    for (const auto& o : snapshot.items) {
+        if (o.type == 'c') {
             Shape::SDL_RenderFillCircle(renderer, static_cast<int>(o.x), static_cast<int>(o.y),
-                                       static_cast<int>(circle->radius));
-        } else if (shapeType == 'b') {
-            const auto* box = dynamic_cast<Shape::Box<double>*>(o.shape);
-            Shape::Box<double>{o.x - box->width / 2, o.y - box->height / 2,
-                              box->width, box->height}.SDL_FillBox(renderer);
+                                       static_cast<int>(o.width));
+        } else if (o.type == 'b') {
+            Shape::Box<Real>{o.x - o.width / 2, o.y - o.height / 2,
+                              o.width, o.height}.SDL_FillBox(renderer);
         }
     }
 }
 
-void Simulate(SDL_Renderer *renderer) {
-    for (auto& obj : objects) {
-        // Apply physics step with friction if on floor
-
-        obj.acceleration += Gravitational_Acceleration;
-
-        bool onFloor = false;
-        char shapeType = obj.shape->getType();
-        if (shapeType == 'c') {
-            auto* circle = dynamic_cast<Shape::Circle<double>*>(obj.shape);
-            onFloor = (obj.y + circle->radius >= 1.0 * iFloor);
-        } else if (shapeType == 'b') {
-            auto* box = dynamic_cast<Shape::Box<double>*>(obj.shape);
-            onFloor = (obj.y + box->height/2 >= 1.0 * iFloor);
+// Physics thread: applies queued input, steps the world in real time and hands every finished step to the
+// render thread, so step N + 1 runs while step N is being drawn
+void Simulate() {
+    using Clock = std::chrono::steady_clock;
+    auto nextTick = Clock::now();
+    SimulationControl control;
+    RewindBuffer<Real> rewind{RewindTicks};
+    rewind.Record(Sandbox);
+
+    while (PhysicsRunning.load(std::memory_order_relaxed)) {
+        ApplyCommands(Sandbox, control, InputCommands);
+
+        if (control.scrub != 0) {
+            rewind.Seek(Sandbox, control.scrub);
+            control.scrub = 0;
+        }
+        if (!control.paused) {
+            Sandbox.Step();
+            rewind.Record(Sandbox);
+            if (DiagnosticsCsv.is_open()) WriteDiagnosticsRow(DiagnosticsCsv, Sandbox.diagnostics.last);
         }
 
-        CurrentTick = SDL_GetTicks();
-        obj.PhysicStep(FrameUpdateInterval, onFloor, 0.3);
-        obj.handleBoundaries(0, WindowSize.w, 0, iFloor);
-    }
-
-    // TODO: applying quadtree
-
-    for (int i = 0; i < objects.size() - 1; i++) {
-        for (int j = i + 1; j < objects.size(); j++) {
-
-            GravitationalEffect(&objects[i], &objects[j]);
+        CaptureSnapshot(Sandbox, FrameState.WriteBuffer());
+        FrameState.Publish();
 
-            if (CheckCollide(objects[i], objects[j])) {
-                CollisionProcess(&objects[i], &objects[j]);
-            }
-        }
+        // Keep simulated time in step with wall time; drop the backlog instead of spiralling when behind
+        nextTick += std::chrono::milliseconds(Sandbox.tickInterval);
+        if (const auto now = Clock::now(); nextTick < now - std::chrono::milliseconds(100)) nextTick = now;
+        std::this_thread::sleep_until(nextTick);
     }
-
-    LatestUpdatedTick = SDL_GetTicks();
-    DrawObjects(renderer);
 }
 
 HuyN_ {
@@ -156,6 +190,17 @@ HuyN_ {
         throw SDLException("Failed to create renderer");
     }
 
+    for (int i = 1; i < argc; i++) {
+        if (string{argv[i]} != "--diagnostics") continue;
+        Sandbox.diagnostics.enabled = true;
+        if (i + 1 < argc && argv[i + 1][0] != '-') {
+            DiagnosticsCsv.open(argv[++i]);
+            if (!DiagnosticsCsv) throw std::runtime_error(string{"Failed to open "} + argv[i]);
+            WriteDiagnosticsHeader(DiagnosticsCsv);
+        }
+    }
+    Uint32 lastTitleUpdate = 0;
+
     SDL_ShowWindow(window);
 
     SDL_AddEventWatch(reinterpret_cast<SDL_EventFilter>(resizingEventWatcher), window);
@@ -163,55 +208,44 @@ HuyN_ {
     SDL_Event event;
     bool isRunning{true};
 
-    int BallsAmount = 4;
-
-    while (BallsAmount--) {
-        auto randX = static_cast<double>(rand() % WindowSize.w - 100 + 100),
-        randY = static_cast<double>(rand() % WindowSize.h - 100 + 100),
-        randRadius = static_cast<double>(rand() % 100 + 50);
-
-        bool containsCheck = true;
-        while (containsCheck) {
-            containsCheck = false;
-            for (const auto& obj : objects) {
-                if (obj.shape->getType() == 'c') {
-                    auto* circle = dynamic_cast<Shape::Circle<double>*>(obj.shape);
-                    if (Vector2{obj.x, obj.y}.distance(Vector2{randX, randY}) <= circle->radius + randRadius) {
-                        randX = static_cast<double>(rand() % WindowSize.w - 100 + 100);
-                        randY = static_cast<double>(rand() % WindowSize.h - 100 + 100);
-                        containsCheck = true;
-                        break;
-                    }
-                }
-            }
-        }
-
-        // Create a circle shape
-        auto* circleShape = new Shape::Circle<double>{
-            Vector2{randX, randY},
-            randRadius
-        };
-
-        objects.emplace_back(
-            randX, randY,
-            0.0, // Will set mass based on shape area
-            circleShape,
-            randX, randY,
-            0, 0
-        );
-
-        auto& lastObject = objects.back();
-        if (lastObject.shape->getType() == 'c') {
-            lastObject.mass = lastObject.shape->area() / 1000;
+    bool isDrawingWall{false};
+    Vector2<Real> wallStart{};
+    bool isPainting{false};
+    Vector2<Real> lastPainted{};
+    bool isFlicking{false};
+    Vector2<Real> flickStart{};
+    Vector2<Real> mouse{};
+    bool paused{false};
+    uint64_t timestep = Sandbox.tickInterval;   // read before the physics thread starts, then only sent
+
+    auto spawnAt = [](const char type, const Vector2<Real> position, const Real size, const Real mass) {
+        SendCommand(Commands::SpawnBody<Real>{type, position, size, size, mass, Vector2<Real>{}});
+    };
+    auto paint = [&](const Vector2<Real> position) {
+        const Real mass = BodyDensity * static_cast<Real>(M_PI) * PaintRadius * PaintRadius;
+        // Never ahead of parked commands: while any wait, painting is dropped like on a full ring
+        if (!PendingCommands.empty() ||
+            !InputCommands.TryPush(Commands::SpawnBody<Real>{'c', position, PaintRadius, PaintRadius, mass, Vector2<Real>{}})) {
+            DroppedPaintCommands++;
         }
-    }
-
-    for (auto& o : objects) {
-        // Newton's 2nd law: F = ma
-        o.ApplyingForce(Gravitational_Acceleration);
-    }
+        lastPainted = position;
+    };
+
+    SpawnSettings<Real> spawn{
+        0, 0, Sandbox.width, Sandbox.Floor(),
+        4,          // count
+        50, 150     // radius range
+    };
+    spawn.maxSpeed = 500;
+    spawn.seed = static_cast<uint64_t>(rand());
+    Sandbox.Spawn(spawn);
+
+    CaptureSnapshot(Sandbox, FrameState.WriteBuffer());
+    FrameState.Publish();
+    std::thread physicsThread(Simulate);
 
     while (isRunning) {
+        FlushPendingCommands();
 
         SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
         SDL_RenderClear(renderer);
@@ -222,16 +256,71 @@ HuyN_ {
                     isRunning = false;
                     break;
                 case SDL_MOUSEBUTTONDOWN:
-                    if (event.button.button == SDL_BUTTON_LEFT) {}
+                    mouse = Vector2<Real>{static_cast<Real>(event.button.x), static_cast<Real>(event.button.y)};
+                    // Left drag draws a wall, right drag paints bodies, middle drag flicks the bodies under the press
+                    if (event.button.button == SDL_BUTTON_LEFT) {
+                        isDrawingWall = true;
+                        wallStart = mouse;
+                    } else if (event.button.button == SDL_BUTTON_RIGHT) {
+                        isPainting = true;
+                        paint(mouse);
+                    } else if (event.button.button == SDL_BUTTON_MIDDLE) {
+                        isFlicking = true;
+                        flickStart = mouse;
+                    }
+                    break;
+                case SDL_MOUSEMOTION:
+                    mouse = Vector2<Real>{static_cast<Real>(event.motion.x), static_cast<Real>(event.motion.y)};
+                    if (isPainting && (mouse - lastPainted).magnitude() >= 2 * PaintRadius) paint(mouse);
+                    break;
+                case SDL_MOUSEBUTTONUP:
+                    mouse = Vector2<Real>{static_cast<Real>(event.button.x), static_cast<Real>(event.button.y)};
+                    if (event.button.button == SDL_BUTTON_LEFT && isDrawingWall) {
+                        isDrawingWall = false;
+                        SendCommand(Commands::AddWall<Real>{wallStart, mouse, 2});
+                    } else if (event.button.button == SDL_BUTTON_RIGHT) {
+                        isPainting = false;
+                    } else if (event.button.button == SDL_BUTTON_MIDDLE && isFlicking) {
+                        isFlicking = false;
+                        SendCommand(Commands::ApplyImpulse<Real>{flickStart, (mouse - flickStart) * FlickImpulsePerPixel});
+                    }
+                    break;
                 case SDL_KEYDOWN:
                     switch (event.key.keysym.sym) {
+                        case SDLK_SPACE:
+                            paused = !paused;
+                            SendCommand(Commands::SetPaused{paused});
+                            break;
+                        case SDLK_EQUALS:
+                        case SDLK_MINUS:
+                            timestep = event.key.keysym.sym == SDLK_EQUALS ? std::min(timestep + 1, MaxTimestep)
+                                                                           : std::max<uint64_t>(timestep - 1, 1);
+                            SendCommand(Commands::SetTimestep{timestep});
+                            break;
+                        case SDLK_LEFT:
+                        case SDLK_RIGHT:
+                            // Scrubbing pauses; space resumes from the shown step and drops the steps after it
+                            paused = true;
+                            SendCommand(Commands::Scrub{event.key.keysym.sym == SDLK_LEFT ? -1 : 1});
+                            break;
+                        case SDLK_c:
+                            spawnAt('c', mouse, SpawnSize, BodyDensity * static_cast<Real>(M_PI) * SpawnSize * SpawnSize);
+                            break;
+                        case SDLK_b:
+                            spawnAt('b', mouse, 2 * SpawnSize, BodyDensity * 4 * SpawnSize * SpawnSize);
+                            break;
                         default:
                             break;
                     }
+                    break;
                 default:
                     break;
             }
         }
+        FrameState.Acquire();
+        const RenderSnapshot<Real>& frame = FrameState.ReadBuffer();
+
+        const int iFloor = static_cast<int>(frame.floor);
         SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
         SDL_RenderDrawLine(renderer, 0, iFloor, WindowSize.w, iFloor);
 
@@ -242,17 +331,44 @@ HuyN_ {
             LinesX.x += 10; LinesX.y += 10;
         }
 
-        // if (CurrentTick = SDL_GetTicks(); CurrentTick - LatestUpdatedTick >= FrameUpdateInterval) {
-        //     Simulate(renderer);
-        //     LatestUpdatedTick = CurrentTick;
-        // }
+        // Walls are drawn at their thickness, row by row, with the same spans as the software rasterizer
+        for (const auto& wall : frame.walls) {
+            const double r = std::max(static_cast<double>(wall.thickness), 0.5);
+            const double ax = static_cast<double>(wall.a.x), ay = static_cast<double>(wall.a.y);
+            const double bx = static_cast<double>(wall.b.x), by = static_cast<double>(wall.b.y);
+            const int top = static_cast<int>(std::floor(std::min(ay, by) - r));
+            const int bottom = static_cast<int>(std::ceil(std::max(ay, by) + r));
+            for (int y = std::max(top, 0); y <= std::min(bottom, WindowSize.h - 1); y++) {
+                double lo, hi;
+                if (!Render::CapsuleSpan(ax, ay, bx, by, r, y + 0.5, lo, hi)) continue;
+                const long left = std::lround(lo), right = std::max(std::lround(hi), left + 1);
+                SDL_RenderDrawLine(renderer, static_cast<int>(left), y, static_cast<int>(right - 1), y);
+            }
+        }
 
-        Simulate(renderer);
+        DrawObjects(renderer, frame);
 
         SDL_RenderPresent(renderer);
 
+        // No text rendering yet, so the readout goes in the title bar, a few times per second
+        if (Sandbox.diagnostics.enabled && SDL_GetTicks() - lastTitleUpdate >= 250) {
+            lastTitleUpdate = SDL_GetTicks();
+            const Diagnostics<Real>& d = frame.diagnostics;
+            char title[192];
+            std::snprintf(title, sizeof(title), "HuyN's Physic Testing Sandbox | E %.4g  KE %.4g  p (%.3g, %.3g)  L %.4g  pen %.3g  vmax %.4g",
+                          static_cast<double>(d.totalEnergy()), static_cast<double>(d.kineticEnergy),
+                          static_cast<double>(d.momentum.x), static_cast<double>(d.momentum.y),
+                          static_cast<double>(d.angularMomentum), static_cast<double>(d.maxPenetration),
+                          static_cast<double>(d.maxSpeed));
+            SDL_SetWindowTitle(window, title);
+        }
+
     }
 
+    PhysicsRunning = false;
+    physicsThread.join();
+    if (DroppedPaintCommands > 0) cerr << DroppedPaintCommands << " painted bodies dropped: input queue full" << endl;
+
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
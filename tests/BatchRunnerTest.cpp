@@ -0,0 +1,93 @@
+// RULE: 1px = 1cm irl
+
+// RunBatch against stepping the same worlds one by one, Summarize on a hand-checked scene, and nested use of
+// one pool: worlds whose particle-mesh gravity shares the batch's pool, and ParallelFor inside ParallelFor.
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Precision.h"
+#include "BatchRunner.h"
+#include "ParticleMesh.h"
+#include "ThreadPool.h"
+#include "World.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+constexpr std::uint64_t Ticks = 60;
+
+template<typename Forces = DefaultForceField<Real>>
+static std::vector<World<Real, Integrator::VelocityVerlet, Forces>> MakeWorlds() {
+    std::vector<World<Real, Integrator::VelocityVerlet, Forces>> worlds;
+    for (int i = 0; i < 6; i++) {
+        auto& world = worlds.emplace_back(Real(400 + 100 * i), Real(400));
+        SpawnSettings<Real> spawn{0, 0, world.width, world.Floor(), static_cast<std::size_t>(10 + 15 * i), 8, 16};
+        spawn.maxSpeed = 300;
+        spawn.seed = static_cast<std::uint64_t>(i);
+        world.Spawn(spawn);
+    }
+    return worlds;
+}
+
+static void TestSummarize() {
+    World<Real> world{100, 100};
+    Shape::Circle<Real> circle{10, 10, 2};
+    world.AddBody(Object<Real>{10, 10, 2, &circle, 3, 4});         // speed 5
+    world.AddBody(Object<Real>{50, 50, 1, &circle, -6, 0});        // speed 6
+    const WorldSummary<Real> summary = Summarize(world, 1.5);
+    CHECK(summary.ticks == 0);
+    CHECK(summary.bodies == 2);
+    CHECK(summary.contacts == 0);
+    CHECK(summary.kineticEnergy == Real(2 * 25 / 2 + 36 / 2));
+    CHECK(summary.momentum.x == Real(0) && summary.momentum.y == Real(8));
+    CHECK(summary.maxSpeed == Real(6));
+    CHECK(summary.seconds == 1.5);
+}
+
+static void TestBatchMatchesSerial() {
+    auto batch = MakeWorlds();
+    auto serial = MakeWorlds();
+    ThreadPool pool{4};
+    const std::vector<WorldSummary<Real>> summaries = RunBatch(batch, Ticks, pool);
+
+    CHECK(summaries.size() == serial.size());
+    for (std::size_t i = 0; i < serial.size() && i < summaries.size(); i++) {
+        for (std::uint64_t t = 0; t < Ticks; t++) serial[i].Step();
+        const WorldSummary<Real> expected = Summarize(serial[i], 0);
+        const WorldSummary<Real>& s = summaries[i];
+        CHECK(s.ticks == Ticks);
+        CHECK(s.bodies == expected.bodies);
+        CHECK(s.contacts == expected.contacts);
+        CHECK(s.kineticEnergy == expected.kineticEnergy);
+        CHECK(s.momentum.x == expected.momentum.x && s.momentum.y == expected.momentum.y);
+        CHECK(s.maxSpeed == expected.maxSpeed);
+        CHECK(s.seconds >= 0);
+    }
+}
+
+// Would deadlock if nested calls waited on the pool's busy workers
+static void TestNestedPool() {
+    ThreadPool pool{4};
+    std::atomic<std::size_t> sum{0};
+    pool.ParallelFor(16, [&](const std::size_t i) {
+        pool.ParallelFor(16, [&](const std::size_t j) { sum.fetch_add(i * 16 + j, std::memory_order_relaxed); });
+    });
+    CHECK(sum.load() == 256 * 255 / 2);
+
+    if constexpr (!std::numeric_limits<Real>::is_exact) {
+        auto worlds = MakeWorlds<ParticleMeshForceField<Real>>();
+        for (auto& world : worlds) world.forces.Get<ParticleMeshGravity<Real>>().pool = &pool;
+        const std::vector<WorldSummary<Real>> summaries = RunBatch(worlds, Ticks, pool);
+        for (const auto& s : summaries) CHECK(s.ticks == Ticks);
+    }
+}
+
+int main() {
+    TestSummarize();
+    TestBatchMatchesSerial();
+    TestNestedPool();
+    return TestExitCode("batch runner");
+}
@@ -0,0 +1,156 @@
+// RULE: 1px = 1cm irl
+
+// ChunkedWorld paging: far chunks freeze and go to disk, then come back with every body field intact, also
+// with a second world paging the same chunk coordinates into the same directory. A page that cannot be read
+// back is counted instead of silently losing its bodies.
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "Precision.h"
+#include "ForceField.h"
+#include "ChunkedWorld.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+// No pairwise gravity and no time passing (tickInterval 0), so bodies keep their exact state across steps
+using PagingWorld = ChunkedWorld<Real, Integrator::VelocityVerlet, ForceField<Real, UniformGravity>>;
+
+constexpr int BodiesPerWorld = 48;
+
+struct Expected {
+    std::uint32_t id;
+    std::uint32_t groups;
+    char type;
+    Real x, y, vx, vy, mass, width, height;
+};
+
+// Scattered over a few chunks far from the camera at the origin; salt makes each world's bodies different
+static std::vector<Expected> Populate(PagingWorld& world, const std::string& directory, const int salt) {
+    world.tickInterval = 0;
+    world.freezeInterval = 1;
+    world.maxResidentChunks = 0;
+    world.pageDirectory = directory;
+
+    std::vector<Expected> expected;
+    for (int i = 0; i < BodiesPerWorld; i++) {
+        const Real x = Real(1000 + (i % 8) * 40 + salt);
+        const Real y = Real((i / 8) * 40 + salt);
+        const Real vx = Real((i * 7 + salt) % 11) - 5, vy = Real((i * 3 + salt) % 7) - 3;
+        const std::uint32_t groups = 1u << ((i + salt) % 5);
+        Object<Real> body = [&] {
+            if (i % 3 == 0) {
+                Shape::Box<Real> box{x, y, Real(6 + i % 4), Real(4 + salt % 3)};
+                return Object<Real>{x, y, Real(2 + i), &box, vx, vy};
+            }
+            Shape::Circle<Real> circle{x, y, Real(3 + (i + salt) % 4)};
+            return Object<Real>{x, y, Real(1 + i), &circle, vx, vy};
+        }();
+        body.groups = groups;
+        const std::uint32_t id = world.AddBody(body);
+
+        Expected e{id, groups, body.shape->getType(), x, y, vx, vy, body.mass, 0, 0};
+        if (e.type == 'c') {
+            e.width = e.height = dynamic_cast<Shape::Circle<Real>*>(body.shape)->radius;
+        } else {
+            const auto* box = dynamic_cast<Shape::Box<Real>*>(body.shape);
+            e.width = box->width;
+            e.height = box->height;
+        }
+        expected.push_back(e);
+    }
+    return expected;
+}
+
+static void StepUntilPaged(PagingWorld& world) {
+    for (int s = 0; s < 10 && (world.PagedChunkCount() == 0 || !world.objects.empty()); s++) world.Step();
+}
+
+static bool Matches(const Object<Real>& body, const Expected& e) {
+    if (body.id != e.id || body.groups != e.groups || body.shape->getType() != e.type) return false;
+    if (body.x != e.x || body.y != e.y || body.velocity.x != e.vx || body.velocity.y != e.vy || body.mass != e.mass) return false;
+    if (body.shape->x != e.x || body.shape->y != e.y) return false;
+    if (e.type == 'c') return dynamic_cast<Shape::Circle<Real>*>(body.shape)->radius == e.width;
+    const auto* box = dynamic_cast<Shape::Box<Real>*>(body.shape);
+    return box->width == e.width && box->height == e.height;
+}
+
+static void CheckAllBack(const PagingWorld& world, const std::vector<Expected>& expected) {
+    CHECK(world.PagedChunkCount() == 0);
+    CHECK(world.objects.size() == expected.size());
+    for (const Expected& e : expected) {
+        const std::uint32_t index = world.IndexOf(e.id);
+        CHECK(index != PagingWorld::NoIndex);
+        if (index != PagingWorld::NoIndex) CHECK(Matches(world.objects[index], e));
+    }
+}
+
+static std::size_t FileCount(const std::filesystem::path& directory) {
+    std::size_t n = 0;
+    for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator(directory)) n++;
+    return n;
+}
+
+static void TestRoundTrip(const std::filesystem::path& directory) {
+    PagingWorld first{100, 50, 100}, second{100, 50, 100};
+    const std::vector<Expected> expectedFirst = Populate(first, directory.string(), 0);
+    std::vector<Expected> expectedSecond = Populate(second, directory.string(), 1);
+
+    StepUntilPaged(first);
+    StepUntilPaged(second);
+    CHECK(first.objects.empty() && second.objects.empty());
+    CHECK(first.PagedChunkCount() > 0);
+    CHECK(first.PagedChunkCount() == second.PagedChunkCount());
+    CHECK(FileCount(directory) == first.PagedChunkCount() + second.PagedChunkCount());
+    CHECK(first.BodyCount() == BodiesPerWorld && second.BodyCount() == BodiesPerWorld);
+
+    // Bring the first world's chunks back while the second still has the same coordinates on disk
+    first.camera = Vector2<Real>{1150, 100};
+    first.wakeRadius = 1000;
+    first.Step();
+    CheckAllBack(first, expectedFirst);
+    CHECK(first.PageInFailures() == 0);
+    CHECK(FileCount(directory) == second.PagedChunkCount());
+
+    second.camera = first.camera;
+    second.wakeRadius = first.wakeRadius;
+    second.Step();
+    CheckAllBack(second, expectedSecond);
+    CHECK(second.PageInFailures() == 0);
+    CHECK(FileCount(directory) == 0);
+}
+
+static void TestUnreadablePage(const std::filesystem::path& directory) {
+    PagingWorld world{100, 50, 100};
+    Populate(world, directory.string(), 0);
+    StepUntilPaged(world);
+    const std::size_t paged = world.PagedChunkCount();
+    CHECK(paged > 0);
+
+    // Pages vanish behind the world's back: waking reports it and keeps the chunks paged
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) std::filesystem::remove(entry.path());
+    world.camera = Vector2<Real>{1150, 100};
+    world.wakeRadius = 1000;
+    world.Step();
+    CHECK(world.PageInFailures() >= paged);
+    CHECK(world.PagedChunkCount() == paged);
+    CHECK(world.objects.empty());
+    CHECK(world.BodyCount() == BodiesPerWorld);
+}
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "huyn_physic_chunk_paging_test";
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    std::filesystem::create_directories(directory);
+
+    TestRoundTrip(directory);
+    TestUnreadablePage(directory);
+
+    std::filesystem::remove_all(directory, error);
+    return TestExitCode("chunk paging");
+}
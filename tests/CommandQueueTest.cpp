@@ -0,0 +1,104 @@
+// RULE: 1px = 1cm irl
+
+// Input commands: the SPSC ring keeps order and refuses pushes when full, also with the two sides on
+// different threads; ApplyCommands applies every kind of command in order and no more than asked.
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <variant>
+
+#include "Precision.h"
+#include "CommandQueue.h"
+#include "World.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+static void TestRingOrderAndCapacity() {
+    SpscRing<int> ring{5};
+    CHECK(ring.Capacity() == 8);
+
+    int value;
+    CHECK(!ring.TryPop(value));
+    for (int i = 0; i < 8; i++) CHECK(ring.TryPush(i));
+    CHECK(!ring.TryPush(8));
+
+    // Wrap around: free three slots, refill them, and everything still comes out in push order
+    for (int i = 0; i < 3; i++) CHECK(ring.TryPop(value) && value == i);
+    for (int i = 8; i < 11; i++) CHECK(ring.TryPush(i));
+    CHECK(!ring.TryPush(11));
+    for (int i = 3; i < 11; i++) CHECK(ring.TryPop(value) && value == i);
+    CHECK(!ring.TryPop(value));
+}
+
+// A small ring forces both sides through the full and empty paths many times
+static void TestRingAcrossThreads() {
+    constexpr std::uint64_t Count = 200000;
+    SpscRing<std::uint64_t> ring{16};
+
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < Count;) {
+            if (ring.TryPush(i)) i++;
+            else std::this_thread::yield();
+        }
+    });
+
+    std::uint64_t expected = 0, outOfOrder = 0, value;
+    while (expected < Count) {
+        if (!ring.TryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != expected) outOfOrder++;
+        expected++;
+    }
+    producer.join();
+
+    CHECK(outOfOrder == 0);
+    CHECK(!ring.TryPop(value));
+}
+
+static void TestApplyCommands() {
+    World<Real> world{1000, 1000};
+    world.gravity = Vector2<Real>{0, 0};
+    SimulationControl control;
+    CommandQueue<Real> queue{16};
+
+    CHECK(queue.TryPush(Commands::SpawnBody<Real>{'c', Vector2<Real>{100, 100}, 10, 10, 2, Vector2<Real>{}}));
+    CHECK(queue.TryPush(Commands::SpawnBody<Real>{'b', Vector2<Real>{500, 500}, 40, 20, 4, Vector2<Real>{1, 0}}));
+    CHECK(queue.TryPush(Commands::ApplyImpulse<Real>{Vector2<Real>{102, 100}, Vector2<Real>{0, 6}}));
+    CHECK(queue.TryPush(Commands::AddWall<Real>{Vector2<Real>{0, 800}, Vector2<Real>{1000, 800}, 4}));
+    CHECK(queue.TryPush(Commands::SetTimestep{0}));
+    CHECK(queue.TryPush(Commands::SetPaused{true}));
+    CHECK(queue.TryPush(Commands::Resize{1200, 900}));
+    CHECK(queue.TryPush(Commands::Scrub{-3}));
+    CHECK(queue.TryPush(Commands::Scrub{-2}));
+
+    // The limit leaves the rest queued, in order
+    CHECK(ApplyCommands(world, control, queue, 2) == 2);
+    CHECK(world.objects.size() == 2);
+    CHECK(world.walls.Empty());
+
+    CHECK(ApplyCommands(world, control, queue) == 7);
+    CHECK(ApplyCommands(world, control, queue) == 0);
+
+    CHECK(world.objects[0].shape->getType() == 'c' && world.objects[0].mass == 2);
+    CHECK(world.objects[1].shape->getType() == 'b' && world.objects[1].velocity.x == 1);
+    // The impulse only reaches the circle under the point: 6 N s on 2 kg
+    CHECK(world.objects[0].velocity.y == 3);
+    CHECK(world.objects[1].velocity.y == 0);
+
+    CHECK(world.walls.Segments().size() == 1 && world.walls.Segments()[0].thickness == 4);
+    CHECK(world.tickInterval == 1);                 // a zero timestep is raised to 1 ms
+    CHECK(world.width == 1200 && world.height == 900);
+    CHECK(control.paused);
+    CHECK(control.scrub == -5);
+}
+
+int main() {
+    TestRingOrderAndCapacity();
+    TestRingAcrossThreads();
+    TestApplyCommands();
+    return TestExitCode("CommandQueue");
+}
@@ -0,0 +1,108 @@
+// RULE: 1px = 1cm irl
+
+// Contact events: one pair stored with the higher id first goes through Begin, Persist and End with the ids
+// lower first and the normal from a to b; the stream's groupMask filters pairs; a full ring counts drops.
+
+#include <cstdint>
+#include <vector>
+
+#include "Precision.h"
+#include "ContactEvents.h"
+#include "World.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+static Object<Real> MakeCircle(const Real x, const Real y, const Real radius) {
+    Shape::Circle<Real> circle{x, y, radius};
+    return Object<Real>{x, y, 1, &circle};
+}
+
+static std::vector<ContactEvent<Real>> DrainAll(ContactEventStream<Real>& stream) {
+    std::vector<ContactEvent<Real>> events;
+    stream.Drain([&](const ContactEvent<Real>& event) { events.push_back(event); });
+    return events;
+}
+
+static void TestPhasesOfOnePair() {
+    World<Real> world{1000, 1000};
+    world.gravity = Vector2<Real>{0, 0};
+    ContactEventStream<Real> stream{256};
+    world.solver.events = &stream;
+
+    world.AddBody(MakeCircle(100, 100, 10));                    // id 0, removed below
+    const std::uint32_t left = world.AddBody(MakeCircle(500, 500, 20));
+    const std::uint32_t right = world.AddBody(MakeCircle(530, 500, 20));
+    CHECK(world.RemoveBody(0));
+    CHECK(world.objects[0].id == right);                        // swapped in: the higher id is stored first
+
+    std::vector<ContactEvent<Real>> events;
+    for (int i = 0; i < 200; i++) {
+        world.Step();
+        for (const auto& event : DrainAll(stream)) events.push_back(event);
+    }
+
+    CHECK(events.size() >= 3);
+    if (events.size() < 3) return;
+    CHECK(events.front().phase == ContactPhase::Begin);
+    CHECK(events.back().phase == ContactPhase::End);
+    for (std::size_t i = 0; i < events.size(); i++) {
+        const ContactEvent<Real>& event = events[i];
+        CHECK(event.a == left && event.b == right);
+        if (i > 0) CHECK(event.tick == events[i - 1].tick + 1);
+        if (i > 0 && i + 1 < events.size()) CHECK(event.phase == ContactPhase::Persist);
+        if (event.phase != ContactPhase::End) {
+            CHECK(event.normal.x > Real(0.99));                 // from the left body to the right one
+            CHECK(event.normalImpulse >= 0);
+        }
+    }
+    CHECK(stream.Dropped() == 0);
+}
+
+static void TestGroupMask() {
+    World<Real> world{1000, 1000};
+    world.gravity = Vector2<Real>{0, 0};
+    ContactEventStream<Real> stream{256};
+    stream.groupMask = 2;
+    world.solver.events = &stream;
+
+    // Two overlapping pairs far apart; only the second has a body in group 2
+    world.AddBody(MakeCircle(200, 200, 20));
+    world.AddBody(MakeCircle(230, 200, 20));
+    Object<Real> tagged = MakeCircle(700, 700, 20);
+    tagged.groups = 1 | 2;
+    const std::uint32_t taggedId = world.AddBody(tagged);
+    const std::uint32_t otherId = world.AddBody(MakeCircle(730, 700, 20));
+
+    world.Step();
+    CHECK(world.solver.contacts.size() == 2);
+    const std::vector<ContactEvent<Real>> events = DrainAll(stream);
+    CHECK(events.size() == 1);
+    for (const auto& event : events) {
+        CHECK(event.a == taggedId && event.b == otherId);
+        CHECK(event.phase == ContactPhase::Begin);
+    }
+}
+
+static void TestDropped() {
+    World<Real> world{1000, 1000};
+    world.gravity = Vector2<Real>{0, 0};
+    ContactEventStream<Real> stream{4};
+    world.solver.events = &stream;
+
+    // A row of overlapping circles: every neighbour pair begins on the first step, more than the ring holds
+    for (int i = 0; i < 10; i++) world.AddBody(MakeCircle(Real(100 + 30 * i), 500, 20));
+    world.Step();
+    const std::size_t contacts = world.solver.contacts.size();
+    CHECK(contacts == 9);
+    CHECK(stream.Capacity() == 4);
+    CHECK(stream.Dropped() == contacts - stream.Capacity());
+    CHECK(DrainAll(stream).size() == stream.Capacity());
+}
+
+int main() {
+    TestPhasesOfOnePair();
+    TestGroupMask();
+    TestDropped();
+    return TestExitCode("contact events");
+}
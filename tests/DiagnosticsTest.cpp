@@ -0,0 +1,94 @@
+// RULE: 1px = 1cm irl
+
+// Diagnostics: the pairwise potential against a hand-computed triangle, with and without the cutoff World copies
+// in from its PairwiseGravity, and the same sums whether or not a pool splits the pair triangle.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Precision.h"
+#include "Diagnostics.h"
+#include "ThreadPool.h"
+#include "World.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+template<typename T>
+static bool Near(const T value, const double expected) {
+    return std::abs(static_cast<double>(value) - expected) <= 1e-4 * std::abs(expected);
+}
+
+// Pairwise gravity only exists in floating point, so everything here is skipped in fixed builds
+template<typename T>
+static void TestPairPotential() {
+    if constexpr (!std::numeric_limits<T>::is_exact) {
+        // A 3-4-5 triangle at rest, heavy enough for G to matter
+        std::vector<Object<T>> objects;
+        Shape::Circle<T> circle{0, 0, 1};
+        objects.emplace_back(T(0), T(0), T(1e10), &circle);
+        objects.emplace_back(T(3), T(0), T(2e10), &circle);
+        objects.emplace_back(T(0), T(4), T(3e10), &circle);
+        const std::vector<Contact<T>> contacts;
+
+        DiagnosticsCollector<T> collector;
+        collector.pairwisePotential = true;
+        collector.Collect(objects, contacts, Vector2<T>{}, 1);
+        const double G = Gravitational_Constant;
+        CHECK(Near(collector.last.potentialEnergy, -G * (2e20 / 3 + 3e20 / 4 + 6e20 / 5)));
+
+        // The 5 px pair is out of reach; the others are shifted to zero at the cutoff
+        collector.pairwiseCutoff = T(4.5);
+        collector.Collect(objects, contacts, Vector2<T>{}, 2);
+        CHECK(Near(collector.last.potentialEnergy, -G * (2e20 * (1 / 3.0 - 1 / 4.5) + 3e20 * (1 / 4.0 - 1 / 4.5))));
+    }
+}
+
+template<typename T>
+static void TestWorldCopiesCutoff() {
+    if constexpr (!std::numeric_limits<T>::is_exact) {
+        World<T, Integrator::VelocityVerlet, PairwiseGravityForceField<T>> world{1000, 1000};
+        world.forces.template Get<PairwiseGravity<T>>().cutoff = 50;
+        world.diagnostics.enabled = true;
+        world.diagnostics.pairwisePotential = true;
+        world.Step();
+        CHECK(world.diagnostics.pairwiseCutoff == 50);
+    }
+}
+
+// More bodies than one chunk of rows, so the pool really splits the triangle
+template<typename T>
+static void TestPoolInvariance() {
+    if constexpr (!std::numeric_limits<T>::is_exact) {
+        World<T> world{2000, 2000};
+        SpawnSettings<T> spawn{0, 0, world.width, world.Floor(), 600, 5, 15};
+        spawn.seed = 7;
+        world.Spawn(spawn);
+        for (auto& o : world.objects) o.mass *= T(1e8);
+        const std::vector<Contact<T>> contacts;
+
+        DiagnosticsCollector<T> serial;
+        serial.pairwisePotential = true;
+        serial.pairwiseCutoff = 300;
+        serial.Collect(world.objects, contacts, world.gravity, 1);
+
+        ThreadPool pool{4};
+        DiagnosticsCollector<T> parallel = serial;
+        parallel.pool = &pool;
+        parallel.Collect(world.objects, contacts, world.gravity, 1);
+
+        CHECK(world.objects.size() > DiagnosticsCollector<T>::PairRowsPerChunk);
+        CHECK(serial.last.potentialEnergy < 0);
+        CHECK(parallel.last.potentialEnergy == serial.last.potentialEnergy);
+        CHECK(parallel.last.kineticEnergy == serial.last.kineticEnergy);
+    }
+}
+
+int main() {
+    TestPairPotential<Real>();
+    TestWorldCopiesCutoff<Real>();
+    TestPoolInvariance<Real>();
+    return TestExitCode("Diagnostics");
+}
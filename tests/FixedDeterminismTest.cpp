@@ -0,0 +1,86 @@
+// RULE: 1px = 1cm irl
+
+// Fixed precision is bit-exact: a scene of circles, boxes and a wall is stepped and its state hashed against a
+// reference recorded once. Every machine, compiler and optimisation level must reproduce that hash, so a
+// failure here means something in the step went through the platform's floating point.
+// Built with HUYN_PHYSIC_PRECISION_FIXED whatever PHYSIC_PRECISION is.
+
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+#include "Precision.h"
+#include "World.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+static_assert(std::is_same_v<Real, Fixed>, "this test must be built with HUYN_PHYSIC_PRECISION_FIXED");
+
+constexpr int Steps = 600;
+constexpr std::uint64_t ReferenceHash = 0x0e96367686d2182dull;    // x86-64 GCC, -O0 to -O3
+
+static void TestScalar() {
+    CHECK((Fixed(1) / 3).raw == 1431655765);
+    CHECK(Fixed(0.1).raw == 429496730);
+    CHECK(Fixed(-2.5).raw == -10737418240);
+    CHECK(sqrt(Fixed(2)).raw == 6074000999);
+    CHECK(sin(FixedPi / 6).raw == 2147483647);         // one step below 0.5: the series is truncated, not rounded
+    CHECK(static_cast<int>(Fixed(-7.9)) == -7);
+    CHECK(static_cast<double>(Fixed::FromRaw(1)) == 1.0 / 4294967296.0);
+}
+
+static void Mix(std::uint64_t& hash, const std::uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (8 * i)) & 0xFF;
+        hash *= 1099511628211ull;       // FNV-1a
+    }
+}
+
+// Bodies placed and launched from integer formulas only, so nothing depends on a random generator
+static std::uint64_t RunScene() {
+    World<Real> world{800, 600};
+    world.walls.AddSegment(Vector2<Real>{100, 450}, Vector2<Real>{500, 380}, 3);
+    for (int i = 0; i < 60; i++) {
+        const Real x = 40 + (i % 12) * 60 + (i / 12) * 7;
+        const Real y = 40 + (i / 12) * 50;
+        const Real vx = (i * 37 % 200) - 100;
+        const Real vy = (i * 53 % 120) - 60;
+        if (i % 4 == 0) {
+            Shape::Box<Real> box{x, y, 18, 12};
+            world.AddBody(Object<Real>{x, y, 216, &box, vx, vy});
+        } else {
+            const Real radius = 6 + i % 5;
+            Shape::Circle<Real> circle{x, y, radius};
+            world.AddBody(Object<Real>{x, y, radius * radius, &circle, vx, vy});
+        }
+    }
+
+    for (int s = 0; s < Steps; s++) world.Step();
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const Object<Real>& body : world.objects) {
+        Mix(hash, body.id);
+        Mix(hash, static_cast<std::uint64_t>(body.x.raw));
+        Mix(hash, static_cast<std::uint64_t>(body.y.raw));
+        Mix(hash, static_cast<std::uint64_t>(body.velocity.x.raw));
+        Mix(hash, static_cast<std::uint64_t>(body.velocity.y.raw));
+    }
+    return hash;
+}
+
+static void TestScene() {
+    const std::uint64_t first = RunScene();
+    CHECK(RunScene() == first);
+    if (first != ReferenceHash) {
+        std::fprintf(stderr, "scene hash %016llx, reference %016llx\n", static_cast<unsigned long long>(first),
+                     static_cast<unsigned long long>(ReferenceHash));
+    }
+    CHECK(first == ReferenceHash);
+}
+
+int main() {
+    TestScalar();
+    TestScene();
+    return TestExitCode("fixed determinism");
+}
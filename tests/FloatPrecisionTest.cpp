@@ -0,0 +1,150 @@
+// RULE: 1px = 1cm irl
+
+// Engine checks at float precision: Object stepping and boundaries, QuadTree insert and query,
+// the collision tests and a short World run. Built with HUYN_PHYSIC_PRECISION_FLOAT whatever PHYSIC_PRECISION is.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+#include "Precision.h"
+#include "PhysicEngine.h"
+#include "ContactSolver.h"
+#include "QuadTree.h"
+#include "World.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+static_assert(std::is_same_v<Real, float>, "this test must be built with HUYN_PHYSIC_PRECISION_FLOAT");
+
+static bool Near(const Real a, const Real b, const Real tolerance = Real(1e-4)) {
+    return std::abs(a - b) <= tolerance * std::max(Real(1), std::abs(b));
+}
+
+static Object<Real> MakeCircle(const Real x, const Real y, const Real radius, const Real vx = 0, const Real vy = 0) {
+    Shape::Circle<Real> circle{x, y, radius};
+    return Object<Real>{x, y, radius * radius, &circle, vx, vy};
+}
+
+static Object<Real> MakeBox(const Real x, const Real y, const Real width, const Real height) {
+    Shape::Box<Real> box{x, y, width, height};
+    return Object<Real>{x, y, width * height, &box};
+}
+
+static void TestObject() {
+    Object<Real> ball = MakeCircle(100, 100, 10, 200, -100);
+    const Object<Real> copy = ball;
+    CHECK(copy.shape != ball.shape);
+    CHECK(copy.shape->getType() == 'c');
+
+    ball.PhysicStep(10);                                // 10 ms at (200, -100) px/s
+    CHECK(Near(ball.x, 102));
+    CHECK(Near(ball.y, 99));
+    CHECK(Near(ball.shape->x, ball.x));
+    CHECK(copy.x == 100);
+
+    ball.x = 5;
+    ball.handleBoundaries(0, 500, 0, 500);
+    CHECK(Near(ball.x, 10));
+    CHECK(ball.velocity.x < 0);
+
+    ball.acceleration = Vector2<Real>{0, 980};
+    ball.velocity = Vector2<Real>{0, 0};
+    for (int i = 0; i < 100; i++) ball.PhysicStep(1);   // 0.1 s of free fall
+    CHECK(Near(ball.velocity.y, 98, Real(1e-3)));
+    CHECK(std::isfinite(ball.y));
+}
+
+static void TestQuadTree() {
+    QuadTree::QuadTree<Real> tree{Shape::Box<Real>{0, 0, 1024, 1024}};
+    std::vector<Vector2<Real>> points;
+    for (int i = 0; i < 400; i++) {
+        points.push_back(Vector2<Real>{static_cast<Real>((i * 37) % 1000) + Real(0.5),
+                                       static_cast<Real>((i * 91) % 1000) + Real(0.25)});
+        CHECK(tree.insert(points.back(), static_cast<std::uint32_t>(i)));
+    }
+    CHECK(!tree.insert(Vector2<Real>{2000, 10}));
+    CHECK(tree.divided);
+
+    const Shape::Box<Real> range{200, 300, 250, 150};
+    std::size_t expected = 0;
+    for (const auto& p : points) expected += range.contains(p);
+    std::size_t found = 0;
+    bool itemsMatch = true;
+    tree.query(range, [&](const Vector2<Real>& p, const std::uint32_t item) {
+        found++;
+        itemsMatch = itemsMatch && points[item].x == p.x && points[item].y == p.y;
+    });
+    CHECK(found == expected);
+    CHECK(itemsMatch);
+
+    // Coincident points stop splitting at MaxDepth instead of recursing forever
+    QuadTree::QuadTree<Real> stacked{Shape::Box<Real>{0, 0, 64, 64}};
+    for (int i = 0; i < 100; i++) CHECK(stacked.insert(Vector2<Real>{Real(3.3), Real(7.7)}));
+}
+
+static void TestCollision() {
+    const Object<Real> a = MakeCircle(0, 0, 10);
+    const Object<Real> touching = MakeCircle(Real(19.9), 0, 10);
+    const Object<Real> apart = MakeCircle(Real(20.1), 0, 10);
+    CHECK(CheckCollide(a, touching));
+    CHECK(!CheckCollide(a, apart));
+
+    CHECK(rectRect(Shape::Box<Real>{0, 0, 10, 10}, Shape::Box<Real>{Real(9.9), 5, 10, 10}));
+    CHECK(!rectRect(Shape::Box<Real>{0, 0, 10, 10}, Shape::Box<Real>{Real(10.1), 5, 10, 10}));
+    CHECK(circleRect(Shape::Circle<Real>{-5, 5, Real(5.1)}, Shape::Box<Real>{0, 0, 10, 10}));
+    CHECK(!circleRect(Shape::Circle<Real>{-5, 5, Real(4.9)}, Shape::Box<Real>{0, 0, 10, 10}));
+
+    Vector2<Real> normal{0, 0};
+    Real penetration = 0;
+    CHECK(ComputeContact(a, touching, normal, penetration));
+    CHECK(Near(penetration, Real(0.1), Real(1e-3)));
+    CHECK(Near(normal.x, 1) && Near(normal.y, 0));
+    CHECK(!ComputeContact(a, apart, normal, penetration));
+
+    const Object<Real> box = MakeBox(0, 0, 20, 20);
+    const Object<Real> onTop = MakeCircle(0, -19, 10);
+    CHECK(ComputeContact(box, onTop, normal, penetration));
+    CHECK(Near(penetration, 1, Real(1e-3)));
+    CHECK(Near(normal.y, -1));
+}
+
+static void TestWorld() {
+    // Head-on collision of equal circles without gravity: momentum is kept and they end up separated
+    World<Real> world{1000, 1000};
+    world.gravity = Vector2<Real>{0, 0};
+    world.AddBody(MakeCircle(400, 500, 20, 300, 0));
+    world.AddBody(MakeCircle(600, 500, 20, -300, 0));
+    for (int i = 0; i < 100; i++) world.Step();
+
+    const Object<Real>& left = world.objects[world.IndexOf(0)];
+    const Object<Real>& right = world.objects[world.IndexOf(1)];
+    CHECK(Near(left.mass * left.velocity.x + right.mass * right.velocity.x, 0, Real(1)));
+    CHECK(left.velocity.x <= 0);
+    CHECK(right.velocity.x >= 0);
+    CHECK(right.x - left.x >= 40 - world.solver.penetrationSlop - Real(0.5));
+
+    // A dropped ball bounces off the floor elastically: it stays inside the bounds and never climbs
+    // noticeably above where it was dropped
+    World<Real> drop{500, 500};
+    drop.AddBody(MakeCircle(250, 100, 10));
+    Real highest = drop.Floor();
+    for (int i = 0; i < 2000; i++) {
+        drop.Step();
+        highest = std::min(highest, drop.objects[0].y);
+        CHECK(std::isfinite(drop.objects[0].y));
+        CHECK(drop.objects[0].y <= drop.Floor() - 10 + Real(0.5));
+    }
+    CHECK(highest >= 100 - Real(5));
+}
+
+int main() {
+    TestObject();
+    TestQuadTree();
+    TestCollision();
+    TestWorld();
+    return TestExitCode("float precision");
+}
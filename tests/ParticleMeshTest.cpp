@@ -0,0 +1,109 @@
+// RULE: 1px = 1cm irl
+
+// Particle-mesh gravity against direct summation: the plain mesh on a spread-out scene, P3M on clumps whose
+// close pairs the mesh alone cannot resolve, and the same bits whatever the thread count.
+// Runs in double whatever PHYSIC_PRECISION is: the accelerations involved are far below the fixed resolution.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "ForceField.h"
+#include "ParticleMesh.h"
+#include "ThreadPool.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+// From a fixed linear congruential sequence: a jittered grid 25 px apart, or a few clumps of bodies with a
+// sparse background
+static std::vector<Object<double>> MakeScene(const bool clumped) {
+    std::uint64_t state = 12345;
+    auto next = [&state] {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;     // [0, 1)
+    };
+    const double clumps[][3] = {{250, 300, 60}, {700, 250, 90}, {500, 650, 40}};
+
+    std::vector<Object<double>> bodies;
+    for (int i = 0; i < 600; i++) {
+        double x, y;
+        if (!clumped) {
+            x = 20 + 25 * (i % 30) + 10 * next();
+            y = 20 + 25 * (i / 30) + 10 * next();
+        } else if (i % 4 == 3) {
+            x = 1000 * next();
+            y = 800 * next();
+        } else {
+            const auto& clump = clumps[i % 3];
+            const double angle = 2 * M_PI * next(), radius = clump[2] * std::sqrt(next());
+            x = clump[0] + radius * std::cos(angle);
+            y = clump[1] + radius * std::sin(angle);
+        }
+        Shape::Circle<double> circle{x, y, 2};
+        bodies.emplace_back(x, y, 1 + 99 * next(), &circle);
+    }
+    return bodies;
+}
+
+template<typename Kernel>
+static std::vector<Vector2<double>> Accelerations(std::vector<Object<double>> bodies, const Kernel& kernel) {
+    for (auto& body : bodies) body.acceleration = Vector2<double>{};
+    kernel.Accumulate(bodies, ForceContext<double>{Vector2<double>{}, 0, 0, nullptr});
+    std::vector<Vector2<double>> result;
+    for (const auto& body : bodies) result.push_back(body.acceleration);
+    return result;
+}
+
+// sqrt(sum |a - reference|^2 / sum |reference|^2)
+static double RelativeError(const std::vector<Vector2<double>>& a, const std::vector<Vector2<double>>& reference) {
+    double error = 0, norm = 0;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        const Vector2<double> d = a[i] - reference[i];
+        error += d.dot(d);
+        norm += reference[i].dot(reference[i]);
+    }
+    return std::sqrt(error / norm);
+}
+
+static bool SameBits(const std::vector<Vector2<double>>& a, const std::vector<Vector2<double>>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (a[i].x != b[i].x || a[i].y != b[i].y) return false;
+    }
+    return true;
+}
+
+int main() {
+    ThreadPool single{1}, several{4};
+
+    const std::vector<Object<double>> grid = MakeScene(false);
+    ParticleMeshGravity<double> mesh;
+    mesh.cellSize = 4;
+    mesh.pool = &single;
+    const std::vector<Vector2<double>> meshSingle = Accelerations(grid, mesh);
+    mesh.pool = &several;
+    const std::vector<Vector2<double>> meshSeveral = Accelerations(grid, mesh);
+    const double meshError = RelativeError(meshSingle, Accelerations(grid, PairwiseGravity<double>{}));
+
+    const std::vector<Object<double>> bodies = MakeScene(true);
+    ParticleMeshGravity<double> p3m;
+    p3m.cellSize = 8;
+    p3m.splitScale = 16;
+    p3m.pool = &single;
+    const std::vector<Vector2<double>> p3mSingle = Accelerations(bodies, p3m);
+    p3m.pool = &several;
+    const std::vector<Vector2<double>> p3mSeveral = Accelerations(bodies, p3m);
+    p3m.pool = nullptr;
+    const std::vector<Vector2<double>> p3mInline = Accelerations(bodies, p3m);
+
+    const double p3mError = RelativeError(p3mSingle, Accelerations(bodies, PairwiseGravity<double>{}));
+    std::printf("RMS error against direct summation: mesh %.4f%%, P3M %.4f%%\n", 100 * meshError, 100 * p3mError);
+    CHECK(meshError < 0.05);
+    CHECK(p3mError < 0.005);
+    CHECK(SameBits(meshSingle, meshSeveral));
+    CHECK(SameBits(p3mSingle, p3mSeveral));
+    CHECK(SameBits(p3mSingle, p3mInline));
+    return TestExitCode("particle mesh");
+}
@@ -0,0 +1,18 @@
+// RULE: 1px = 1cm irl
+
+// Part of PhysicAPITest: a consumer that includes PhysicAPI.h with a different precision than the library's
+
+#if defined(HUYN_PHYSIC_PRECISION_FLOAT)
+#undef HUYN_PHYSIC_PRECISION_FLOAT
+#define HUYN_PHYSIC_PRECISION_FIXED
+#elif defined(HUYN_PHYSIC_PRECISION_FIXED)
+#undef HUYN_PHYSIC_PRECISION_FIXED
+#else
+#define HUYN_PHYSIC_PRECISION_FLOAT
+#endif
+
+#include "PhysicAPI.h"
+
+HuyNPhysic_Precision MismatchedHeaderPrecision(void) {
+    return HUYN_PHYSIC_HEADER_PRECISION;
+}
@@ -0,0 +1,99 @@
+// RULE: 1px = 1cm irl
+
+// The C interface, compiled as C: create a world, add bodies, step, read the state back, remove bodies,
+// and catch a consumer whose PhysicAPI.h was built for a different precision than the library.
+
+#include <math.h>
+#include <stdio.h>
+
+#include "PhysicAPI.h"
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+// PhysicAPIMismatch.c includes PhysicAPI.h with a different precision macro
+HuyNPhysic_Precision MismatchedHeaderPrecision(void);
+
+#if HUYN_PHYSIC_HEADER_PRECISION == HuyNPhysic_PrecisionFixed
+static HuyNPhysic_Real ToReal(const double value) { return (HuyNPhysic_Real)llround(value * 4294967296.0); }
+static double FromReal(const HuyNPhysic_Real value) { return (double)value / 4294967296.0; }
+#else
+static HuyNPhysic_Real ToReal(const double value) { return (HuyNPhysic_Real)value; }
+static double FromReal(const HuyNPhysic_Real value) { return (double)value; }
+#endif
+
+static void TestPrecision(void) {
+    CHECK(HuyNPhysic_GetPrecision() == HUYN_PHYSIC_HEADER_PRECISION);
+    CHECK(HuyNPhysic_RealSize() == sizeof(HuyNPhysic_Real));
+    // The run-time check PhysicAPI.h asks consumers to make, from the side that got it wrong
+    CHECK(HuyNPhysic_GetPrecision() != MismatchedHeaderPrecision());
+}
+
+static void TestStepAndReadBack(void) {
+    HuyNPhysic_World* world = HuyNPhysic_CreateWorld(ToReal(1000), ToReal(1000), ToReal(0));
+    CHECK(world != NULL);
+    if (!world) return;
+    HuyNPhysic_Reserve(world, 8);
+    HuyNPhysic_SetGravity(world, ToReal(0), ToReal(0));
+    HuyNPhysic_SetTickInterval(world, 10);
+
+    // Far apart, so nothing touches: a circle at rest, a circle moving right at 100 px/s, and a box
+    const HuyNPhysic_Real circlePositions[4] = {ToReal(100), ToReal(100), ToReal(300), ToReal(100)};
+    const HuyNPhysic_Real circleVelocities[4] = {ToReal(0), ToReal(0), ToReal(100), ToReal(0)};
+    const HuyNPhysic_Real radii[2] = {ToReal(10), ToReal(10)};
+    const HuyNPhysic_Real circleMasses[2] = {ToReal(1), ToReal(2)};
+    uint32_t circleIds[2];
+    CHECK(HuyNPhysic_AddCircles(world, 2, circlePositions, circleVelocities, radii, circleMasses, circleIds) == 2);
+
+    const HuyNPhysic_Real boxPosition[2] = {ToReal(600), ToReal(500)};
+    const HuyNPhysic_Real boxSize[2] = {ToReal(40), ToReal(20)};
+    const HuyNPhysic_Real boxMass[1] = {ToReal(3)};
+    uint32_t boxId;
+    CHECK(HuyNPhysic_AddBoxes(world, 1, boxPosition, NULL, boxSize, boxMass, &boxId) == 1);
+    CHECK(circleIds[0] != circleIds[1] && boxId != circleIds[0] && boxId != circleIds[1]);
+    CHECK(HuyNPhysic_BodyCount(world) == 3);
+
+    // 10 steps of 10 ms: the moving circle covers 10 px
+    CHECK(HuyNPhysic_Step(world, 10) == 10);
+    CHECK(HuyNPhysic_Tick(world) == 10);
+
+    uint32_t ids[3];
+    HuyNPhysic_Real positions[6], velocities[6];
+    CHECK(HuyNPhysic_ReadState(world, 3, ids, positions, velocities) == 3);
+    CHECK(ids[0] == circleIds[0] && ids[1] == circleIds[1] && ids[2] == boxId);
+    CHECK(fabs(FromReal(positions[0]) - 100) < 1e-3 && fabs(FromReal(positions[1]) - 100) < 1e-3);
+    CHECK(fabs(FromReal(positions[2]) - 310) < 1e-3 && fabs(FromReal(positions[3]) - 100) < 1e-3);
+    CHECK(fabs(FromReal(velocities[2]) - 100) < 1e-3 && fabs(FromReal(velocities[3])) < 1e-3);
+    CHECK(fabs(FromReal(positions[4]) - 600) < 1e-3 && fabs(FromReal(positions[5]) - 500) < 1e-3);
+
+    // Gravity turned on pulls the resting circle down
+    HuyNPhysic_SetGravity(world, ToReal(0), ToReal(980));
+    CHECK(HuyNPhysic_Step(world, 5) == 5);
+    CHECK(HuyNPhysic_ReadState(world, 1, NULL, positions, velocities) == 1);
+    CHECK(FromReal(positions[1]) > 100 && FromReal(velocities[1]) > 0);
+
+    // Removal skips unknown ids and moves the last body into the hole
+    const uint32_t removed[2] = {circleIds[0], 12345};
+    CHECK(HuyNPhysic_RemoveBodies(world, 2, removed) == 1);
+    CHECK(HuyNPhysic_BodyCount(world) == 2);
+    CHECK(HuyNPhysic_ReadState(world, 3, ids, NULL, NULL) == 2);
+    CHECK(ids[0] == boxId && ids[1] == circleIds[1]);
+
+    HuyNPhysic_DestroyWorld(world);
+}
+
+int main(void) {
+    TestPrecision();
+    TestStepAndReadBack();
+
+    if (failures) fprintf(stderr, "PhysicAPI: %d check(s) failed\n", failures);
+    else printf("PhysicAPI: all checks passed\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+// RULE: 1px = 1cm irl
+
+// Rewind buffer: seeking back and forth restores every body, id and the tick exactly, also across a removal
+// and a body changing shape; recording after seeking back drops the later ticks; a full ring keeps the newest;
+// a resting scene shares every chunk with the tick before.
+
+#include <cstdint>
+#include <vector>
+
+#include "Precision.h"
+#include "RewindBuffer.h"
+#include "World.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+struct BodyRecord {
+    std::uint32_t id, groups;
+    char type;
+    Real x, y, vx, vy, ax, ay, mass, width, height;
+
+    bool operator==(const BodyRecord&) const = default;
+};
+
+struct WorldRecord {
+    std::uint64_t tick;
+    std::uint32_t nextId;
+    std::vector<BodyRecord> bodies;
+
+    bool operator==(const WorldRecord&) const = default;
+};
+
+static WorldRecord Read(const World<Real>& world) {
+    WorldRecord record{world.tick, world.NextId(), {}};
+    for (const Object<Real>& o : world.objects) {
+        BodyRecord b{o.id, o.groups, o.shape->getType(), o.x, o.y, o.velocity.x, o.velocity.y,
+                     o.acceleration.x, o.acceleration.y, o.mass, 0, 0};
+        if (b.type == 'c') {
+            b.width = b.height = dynamic_cast<Shape::Circle<Real>*>(o.shape)->radius;
+        } else {
+            const auto* box = dynamic_cast<Shape::Box<Real>*>(o.shape);
+            b.width = box->width;
+            b.height = box->height;
+        }
+        record.bodies.push_back(b);
+    }
+    return record;
+}
+
+// Every id resolves to the body carrying it
+static bool IdsResolve(const World<Real>& world) {
+    for (std::size_t i = 0; i < world.objects.size(); i++) {
+        if (world.IndexOf(world.objects[i].id) != i) return false;
+    }
+    return true;
+}
+
+static World<Real> MakeWorld(const std::size_t bodies) {
+    World<Real> world{2000, 2000};
+    SpawnSettings<Real> spawn{0, 0, world.width, world.Floor(), bodies, 5, 12};
+    spawn.maxSpeed = 200;
+    spawn.seed = 3;
+    world.Spawn(spawn);
+    return world;
+}
+
+static void TestSeek() {
+    World<Real> world = MakeWorld(600);         // three chunks
+    RewindBuffer<Real> rewind{64};
+    std::vector<WorldRecord> history;
+    rewind.Record(world);
+    history.push_back(Read(world));
+
+    for (int t = 1; t <= 20; t++) {
+        world.Step();
+        if (t == 5) {
+            // Removal moves the last body into the hole; groups are rewound as well
+            world.RemoveBody(world.objects[10].id);
+            world.objects[20].groups = 6;
+        }
+        if (t == 8) {
+            // A circle gives way to a box under a fresh id
+            world.RemoveBody(world.objects[30].id);
+            Shape::Box<Real> box{1000, 1000, 30, 10};
+            world.AddBody(Object<Real>{1000, 1000, 5, &box});
+        }
+        rewind.Record(world);
+        history.push_back(Read(world));
+    }
+    CHECK(rewind.Size() == 21);
+    CHECK(rewind.Offset() == 0);
+
+    CHECK(rewind.Seek(world, -10) == -10);
+    CHECK(rewind.Offset() == -10);
+    CHECK(Read(world) == history[10]);
+    CHECK(IdsResolve(world));
+
+    // Back over the removals and the shape change, then forward past them again
+    CHECK(rewind.Seek(world, -6) == -6);
+    CHECK(Read(world) == history[4]);
+    CHECK(IdsResolve(world));
+    CHECK(rewind.Seek(world, 10) == 10);
+    CHECK(Read(world) == history[14]);
+    CHECK(IdsResolve(world));
+
+    // Clamped at both ends
+    CHECK(rewind.Seek(world, -100) == -14);
+    CHECK(Read(world) == history[0]);
+    CHECK(rewind.Seek(world, 100) == 20);
+    CHECK(Read(world) == history[20]);
+    CHECK(rewind.Seek(world, 1) == 0);
+
+    // Resuming from tick 15 replaces ticks 16 to 20 with the new one
+    CHECK(rewind.Seek(world, -5) == -5);
+    world.Step();
+    rewind.Record(world);
+    const WorldRecord resumed = Read(world);
+    CHECK(resumed.tick == 16);
+    CHECK(rewind.Size() == 17);
+    CHECK(rewind.Offset() == 0);
+    CHECK(rewind.Seek(world, 1) == 0);
+    CHECK(rewind.Seek(world, -1) == -1);
+    CHECK(Read(world) == history[15]);
+    CHECK(rewind.Seek(world, 1) == 1);
+    CHECK(Read(world) == resumed);
+}
+
+static void TestFullRing() {
+    World<Real> world = MakeWorld(50);
+    RewindBuffer<Real> rewind{8};
+    std::vector<WorldRecord> history;
+    for (int t = 0; t < 20; t++) {
+        if (t > 0) world.Step();
+        rewind.Record(world);
+        history.push_back(Read(world));
+    }
+    CHECK(rewind.Size() == 8);
+    CHECK(rewind.Seek(world, -100) == -7);
+    CHECK(Read(world) == history[12]);
+    CHECK(rewind.Seek(world, 3) == 3);
+    CHECK(Read(world) == history[15]);
+}
+
+// Still bodies apart from each other, without gravity: nothing changes between ticks
+static void TestRestingSceneSharesChunks() {
+    World<Real> world{3000, 3000};
+    world.gravity = Vector2<Real>{0, 0};
+    for (int i = 0; i < 600; i++) {
+        const Real x = Real(50 + 100 * (i % 25)), y = Real(50 + 100 * (i / 25));
+        Shape::Circle<Real> circle{x, y, 10};
+        world.AddBody(Object<Real>{x, y, 1, &circle});
+    }
+    const std::size_t chunks = (world.objects.size() + RewindBuffer<Real>::ChunkSize - 1) / RewindBuffer<Real>::ChunkSize;
+
+    RewindBuffer<Real> rewind{16};
+    rewind.Record(world);
+    CHECK(rewind.LastCopiedChunks() == chunks);
+    for (int t = 0; t < 5; t++) {
+        world.Step();
+        rewind.Record(world);
+        CHECK(rewind.LastCopiedChunks() == 0);
+    }
+
+    // One body set moving copies only its own chunk
+    world.objects[RewindBuffer<Real>::ChunkSize + 1].velocity = Vector2<Real>{10, 0};
+    world.Step();
+    rewind.Record(world);
+    CHECK(rewind.LastCopiedChunks() == 1);
+}
+
+int main() {
+    TestSeek();
+    TestFullRing();
+    TestRestingSceneSharesChunks();
+    return TestExitCode("RewindBuffer");
+}
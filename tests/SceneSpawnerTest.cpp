@@ -0,0 +1,140 @@
+// RULE: 1px = 1cm irl
+
+// Scene spawner: no two spawned bodies overlap or come closer than the gap, every body lies inside the region,
+// one seed always gives the same scene, and a region too small for the count ends early instead of looping.
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Precision.h"
+#include "SceneSpawner.h"
+#include "World.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+// Radius of the disc the spawner sampled: the circle itself, or the circle around a square box
+static double DiscRadius(const Object<Real>& o) {
+    if (o.shape->getType() == 'c') return static_cast<double>(dynamic_cast<Shape::Circle<Real>*>(o.shape)->radius);
+    return static_cast<double>(dynamic_cast<Shape::Box<Real>*>(o.shape)->width) / std::sqrt(2.0);
+}
+
+// Pairs closer than their radii plus the gap, allowing for rounding in the scalar type
+static int CountOverlaps(const std::vector<Object<Real>>& objects, const double gap) {
+    int overlaps = 0;
+    for (std::size_t i = 0; i < objects.size(); i++) {
+        for (std::size_t j = i + 1; j < objects.size(); j++) {
+            const double dx = static_cast<double>(objects[j].x - objects[i].x);
+            const double dy = static_cast<double>(objects[j].y - objects[i].y);
+            const double minDistance = DiscRadius(objects[i]) + DiscRadius(objects[j]) + gap;
+            if (std::sqrt(dx * dx + dy * dy) < minDistance * (1 - 1e-4)) overlaps++;
+        }
+    }
+    return overlaps;
+}
+
+static int CountOutside(const std::vector<Object<Real>>& objects, const SpawnSettings<Real>& s) {
+    int outside = 0;
+    const double slack = 1e-3;
+    for (const auto& o : objects) {
+        const double r = DiscRadius(o), x = static_cast<double>(o.x), y = static_cast<double>(o.y);
+        if (x - r < static_cast<double>(s.minX) - slack || x + r > static_cast<double>(s.maxX) + slack ||
+            y - r < static_cast<double>(s.minY) - slack || y + r > static_cast<double>(s.maxY) + slack) outside++;
+    }
+    return outside;
+}
+
+static void TestNoOverlap() {
+    struct Case {
+        SpawnSettings<Real> settings;
+        const char* name;
+    };
+    Case cases[] = {
+        {{0, 0, 1200, 800, 600, 5, 15}, "circles"},
+        {{100, 50, 900, 650, 120, 8, 30}, "wide radius range"},
+        {{0, 0, 1000, 1000, 500, 6, 12}, "boxes and circles"},
+        {{0, 0, 1000, 1000, 300, 10, 10}, "one radius with a gap"},
+    };
+    cases[2].settings.boxFraction = Real(0.5);
+    cases[3].settings.gap = 4;
+
+    for (auto& c : cases) {
+        for (std::uint64_t seed = 0; seed < 3; seed++) {
+            c.settings.seed = seed;
+            std::vector<Object<Real>> objects;
+            const std::size_t spawned = SpawnScene(objects, c.settings);
+            CHECK(spawned == c.settings.count);
+            CHECK(objects.size() == spawned);
+            CHECK(CountOverlaps(objects, static_cast<double>(c.settings.gap)) == 0);
+            CHECK(CountOutside(objects, c.settings) == 0);
+        }
+    }
+
+    // The mix really has both kinds
+    std::vector<Object<Real>> mixed;
+    SpawnScene(mixed, cases[2].settings);
+    std::size_t boxes = 0;
+    for (const auto& o : mixed) boxes += o.shape->getType() == 'b';
+    CHECK(boxes > 0 && boxes < mixed.size());
+}
+
+// A world spawned into after bodies were added by hand keeps its ids unique and resolvable, and its
+// spawned bodies apart
+static void TestWorldSpawn() {
+    World<Real> world{800, 600};
+    Shape::Circle<Real> circle{-100, -100, 5};
+    world.AddBody(Object<Real>{-100, -100, 1, &circle});
+    SpawnSettings<Real> spawn{0, 0, world.width, world.Floor(), 200, 6, 14};
+    spawn.seed = 9;
+    CHECK(world.Spawn(spawn) == 200);
+    CHECK(world.objects.size() == 201);
+    for (std::size_t i = 0; i < world.objects.size(); i++) CHECK(world.IndexOf(world.objects[i].id) == i);
+    const std::vector<Object<Real>> spawned(world.objects.begin() + 1, world.objects.end());
+    CHECK(CountOverlaps(spawned, 0) == 0);
+}
+
+static void TestDeterministic() {
+    SpawnSettings<Real> spawn{0, 0, 1000, 1000, 300, 5, 20};
+    spawn.boxFraction = Real(0.3);
+    spawn.maxSpeed = 100;
+    spawn.seed = 42;
+    std::vector<Object<Real>> first, second;
+    SpawnScene(first, spawn);
+    SpawnScene(second, spawn);
+    CHECK(first.size() == second.size());
+    bool same = first.size() == second.size();
+    for (std::size_t i = 0; same && i < first.size(); i++) {
+        same = first[i].x == second[i].x && first[i].y == second[i].y && first[i].mass == second[i].mass &&
+               first[i].velocity.x == second[i].velocity.x && first[i].shape->getType() == second[i].shape->getType();
+    }
+    CHECK(same);
+
+    spawn.seed = 43;
+    std::vector<Object<Real>> other;
+    SpawnScene(other, spawn);
+    CHECK(other.size() != first.size() || other[0].x != first[0].x || other[0].y != first[0].y);
+}
+
+// Far more bodies than fit: spawning stops once there is no room, and what it placed still does not overlap
+static void TestFullRegion() {
+    SpawnSettings<Real> spawn{0, 0, 200, 200, 100000, 10, 10};
+    std::vector<Object<Real>> objects;
+    const std::size_t spawned = SpawnScene(objects, spawn);
+    CHECK(spawned > 20 && spawned < 200);
+    CHECK(CountOverlaps(objects, 0) == 0);
+    CHECK(CountOutside(objects, spawn) == 0);
+
+    // Nothing fits in a region narrower than one body
+    std::vector<Object<Real>> none;
+    CHECK(SpawnScene(none, SpawnSettings<Real>{0, 0, 15, 100, 10, 10, 10}) == 0);
+    CHECK(none.empty());
+}
+
+int main() {
+    TestNoOverlap();
+    TestWorldSpawn();
+    TestDeterministic();
+    TestFullRegion();
+    return TestExitCode("SceneSpawner");
+}
@@ -0,0 +1,111 @@
+// RULE: 1px = 1cm irl
+
+// Software rasterizer: packed pixels hold R, G, B, A in memory order, and walls are filled at their thickness,
+// checked pixel by pixel against the distance from each pixel centre to the wall, in bands and across a pool.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include "Precision.h"
+#include "SoftwareRasterizer.h"
+#include "StateBuffer.h"
+#include "ThreadPool.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+constexpr int Width = 320, Height = 240;
+
+static void TestPackedByteOrder() {
+    const std::uint32_t pixel = Render::PackRGBA(0x11, 0x22, 0x33, 0x44);
+    unsigned char bytes[4];
+    std::memcpy(bytes, &pixel, sizeof(bytes));
+    CHECK(bytes[0] == 0x11 && bytes[1] == 0x22 && bytes[2] == 0x33 && bytes[3] == 0x44);
+}
+
+static double DistanceToWall(const Spatial::WallSegment<Real>& wall, const double px, const double py) {
+    const Vector2<Real> closest = wall.ClosestPoint(Vector2<Real>{static_cast<Real>(px), static_cast<Real>(py)});
+    return std::hypot(px - static_cast<double>(closest.x), py - static_cast<double>(closest.y));
+}
+
+// Pixels whose centre is inside a wall must be lit. Lit pixels may lie outside by up to half a pixel, where a
+// row only grazes a wall and still gets its one pixel; centres within a hair of the edge may go either way.
+static int CountWrongPixels(const Render::Framebuffer& fb, const RenderSnapshot<Real>& snapshot,
+                            const std::uint32_t foreground) {
+    int wrong = 0;
+    for (int y = 0; y < fb.height; y++) {
+        for (int x = 0; x < fb.width; x++) {
+            double nearest = INFINITY, reach = 0;
+            for (const auto& wall : snapshot.walls) {
+                const double r = std::max(static_cast<double>(wall.thickness), 0.5);
+                const double d = DistanceToWall(wall, x + 0.5, y + 0.5) - r;
+                if (d < nearest) {
+                    nearest = d;
+                    reach = r;
+                }
+            }
+            const double tolerance = 1e-3 * std::max(reach, 1.0);
+            const bool lit = fb.Row(y)[x] == foreground;
+            if (!lit && nearest < -tolerance) wrong++;
+            if (lit && nearest > 0.5 + tolerance) wrong++;
+        }
+    }
+    return wrong;
+}
+
+static void TestWallThickness() {
+    RenderSnapshot<Real> snapshot;
+    snapshot.floor = 10 * Height;               // out of the frame
+    snapshot.walls.push_back({Vector2<Real>{40, 100}, Vector2<Real>{280, 100}, 5});    // horizontal
+    snapshot.walls.push_back({Vector2<Real>{60, 20}, Vector2<Real>{60, 220}, 3});      // vertical
+    snapshot.walls.push_back({Vector2<Real>{100, 30}, Vector2<Real>{300, 200}, 8});    // diagonal, across bands
+    snapshot.walls.push_back({Vector2<Real>{150, 150}, Vector2<Real>{150, 150}, 6});   // a single point
+    snapshot.walls.push_back({Vector2<Real>{200, 10}, Vector2<Real>{310, 60}, Real(0.2)});   // thinner than a pixel
+
+    Render::SoftwareRasterizer rasterizer{16};
+    Render::Framebuffer fb{Width, Height};
+    rasterizer.Draw(fb, snapshot);
+    CHECK(CountWrongPixels(fb, snapshot, rasterizer.foreground) == 0);
+
+    // Thick walls really are thick: five pixels either side of the horizontal one, and the rounded ends
+    CHECK(fb.Row(96)[160] == rasterizer.foreground && fb.Row(103)[160] == rasterizer.foreground);
+    CHECK(fb.Row(94)[160] == rasterizer.background && fb.Row(106)[160] == rasterizer.background);
+    CHECK(fb.Row(100)[36] == rasterizer.foreground && fb.Row(100)[33] == rasterizer.background);
+
+    // The thin wall leaves no gaps: every row it crosses has a lit pixel
+    for (int y = 11; y < 60; y++) {
+        bool lit = false;
+        for (int x = 195; x < Width; x++) lit |= fb.Row(y)[x] == rasterizer.foreground;
+        CHECK(lit);
+    }
+
+    ThreadPool pool{4};
+    Render::Framebuffer pooled{Width, Height};
+    rasterizer.Draw(pooled, snapshot, &pool);
+    CHECK(pooled.pixels == fb.pixels);
+}
+
+static void TestRandomWalls() {
+    std::mt19937 rng{5};
+    std::uniform_real_distribution<double> x(-40, Width + 40), y(-40, Height + 40), thickness(0.3, 12);
+    RenderSnapshot<Real> snapshot;
+    snapshot.floor = 10 * Height;
+    for (int i = 0; i < 12; i++) {
+        snapshot.walls.push_back({Vector2<Real>{static_cast<Real>(x(rng)), static_cast<Real>(y(rng))},
+                                  Vector2<Real>{static_cast<Real>(x(rng)), static_cast<Real>(y(rng))},
+                                  static_cast<Real>(thickness(rng))});
+    }
+    Render::SoftwareRasterizer rasterizer{32};
+    Render::Framebuffer fb{Width, Height};
+    rasterizer.Draw(fb, snapshot);
+    CHECK(CountWrongPixels(fb, snapshot, rasterizer.foreground) == 0);
+}
+
+int main() {
+    TestPackedByteOrder();
+    TestWallThickness();
+    TestRandomWalls();
+    return TestExitCode("SoftwareRasterizer");
+}
@@ -0,0 +1,104 @@
+// RULE: 1px = 1cm irl
+
+// Static BVH queries against testing every wall's bounds by hand: random walls and boxes, walls added after a
+// build, a box covering everything, and many identical walls, which median splits must still spread over leaves.
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Precision.h"
+#include "StaticBVH.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+using Spatial::AABB;
+using Spatial::StaticBVH;
+using Spatial::WallSegment;
+
+static AABB<Real> Bounds(const WallSegment<Real>& s) {
+    return AABB<Real>{std::min(s.a.x, s.b.x) - s.thickness, std::min(s.a.y, s.b.y) - s.thickness,
+                      std::max(s.a.x, s.b.x) + s.thickness, std::max(s.a.y, s.b.y) + s.thickness};
+}
+
+static std::vector<std::size_t> Query(const StaticBVH<Real>& bvh, const AABB<Real>& box) {
+    std::vector<std::size_t> hits;
+    bvh.Query(box, [&](const WallSegment<Real>& wall) {
+        hits.push_back(static_cast<std::size_t>(&wall - bvh.Segments().data()));
+    });
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+static std::vector<std::size_t> BruteForce(const StaticBVH<Real>& bvh, const AABB<Real>& box) {
+    std::vector<std::size_t> hits;
+    for (std::size_t i = 0; i < bvh.Segments().size(); i++) {
+        if (Bounds(bvh.Segments()[i]).overlaps(box)) hits.push_back(i);
+    }
+    return hits;
+}
+
+static AABB<Real> RandomBox(std::mt19937& rng) {
+    std::uniform_real_distribution<double> position(-100, 2100), size(0, 300);
+    const double x = position(rng), y = position(rng);
+    return AABB<Real>{Real(x), Real(y), Real(x + size(rng)), Real(y + size(rng))};
+}
+
+static void AddRandomWalls(StaticBVH<Real>& bvh, std::mt19937& rng, const int count) {
+    std::uniform_real_distribution<double> position(0, 2000), offset(-80, 80), thickness(0.5, 6);
+    for (int i = 0; i < count; i++) {
+        const double x = position(rng), y = position(rng);
+        bvh.AddSegment(Vector2<Real>{Real(x), Real(y)}, Vector2<Real>{Real(x + offset(rng)), Real(y + offset(rng))},
+                       Real(thickness(rng)));
+    }
+}
+
+static int CountMismatches(const StaticBVH<Real>& bvh, std::mt19937& rng, const int queries) {
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        const AABB<Real> box = RandomBox(rng);
+        if (Query(bvh, box) != BruteForce(bvh, box)) mismatches++;
+    }
+    return mismatches;
+}
+
+static void TestRandomWalls() {
+    std::mt19937 rng{11};
+    StaticBVH<Real> bvh;
+    AddRandomWalls(bvh, rng, 3000);
+    bvh.AddPolygon({Vector2<Real>{100, 100}, Vector2<Real>{400, 120}, Vector2<Real>{250, 500}}, 3);
+    bvh.Update();
+    CHECK(CountMismatches(bvh, rng, 1000) == 0);
+
+    // Edits after a build are seen once the tree is updated
+    AddRandomWalls(bvh, rng, 500);
+    bvh.Update();
+    CHECK(CountMismatches(bvh, rng, 1000) == 0);
+
+    const std::vector<std::size_t> all = Query(bvh, AABB<Real>{-1000, -1000, 4000, 4000});
+    CHECK(all.size() == bvh.Segments().size());
+
+    CHECK(Query(bvh, AABB<Real>{5000, 5000, 5100, 5100}).empty());
+}
+
+static void TestIdenticalWalls() {
+    StaticBVH<Real> bvh;
+    for (int i = 0; i < 5000; i++) bvh.AddSegment(Vector2<Real>{10, 10}, Vector2<Real>{20, 10}, 1);
+    bvh.Update();
+    CHECK(Query(bvh, AABB<Real>{15, 9, 16, 11}).size() == 5000);
+    CHECK(Query(bvh, AABB<Real>{30, 30, 40, 40}).empty());
+}
+
+static void TestEmpty() {
+    StaticBVH<Real> bvh;
+    bvh.Update();
+    CHECK(Query(bvh, AABB<Real>{0, 0, 100, 100}).empty());
+}
+
+int main() {
+    TestRandomWalls();
+    TestIdenticalWalls();
+    TestEmpty();
+    return TestExitCode("StaticBVH");
+}
@@ -0,0 +1,110 @@
+// RULE: 1px = 1cm irl
+
+// Fails if a steady-state step allocates. Built only with PHYSIC_TRACK_ALLOCATIONS, linked with
+// src/AllocationHooks.cpp so every operator new is counted.
+//   - World: the sandbox's Simulate loop body (queued input, step, rewind recording, snapshot for the renderer)
+//   - ChunkedWorld: a resting pile at the camera and a frozen one far away, across freeze sweeps
+
+#include <cstdio>
+
+#include "Precision.h"
+#include "AllocationTracker.h"
+#include "World.h"
+#include "ChunkedWorld.h"
+#include "CommandQueue.h"
+#include "RewindBuffer.h"
+#include "StateBuffer.h"
+
+using namespace HuyNPhysic;
+
+static_assert(AllocationTrackingEnabled, "build with HUYN_PHYSIC_TRACK_ALLOCATIONS and src/AllocationHooks.cpp");
+
+// Steps before this many may allocate while buffers grow to the scene
+constexpr int WarmupTicks = 100,
+              MeasuredTicks = 400;
+
+static void PrintAllocations(const char* title, const AllocationStats& stats) {
+    std::fprintf(stderr, "%s\n", title);
+    for (std::size_t i = 0; i < AllocationPhaseCount; i++) {
+        const auto phase = static_cast<AllocationPhase>(i);
+        if (stats[phase].allocations == 0) continue;
+        std::fprintf(stderr, "  %-12s %10llu allocations %12llu bytes\n", AllocationPhaseName(phase),
+                     static_cast<unsigned long long>(stats[phase].allocations),
+                     static_cast<unsigned long long>(stats[phase].bytes));
+    }
+}
+
+// Runs step() through the warm-up, then counts what the measured steps allocate. Returns true if nothing did.
+template<typename Step>
+static bool SteadyStateIsAllocationFree(const char* name, Step&& step) {
+    for (int t = 0; t < WarmupTicks; t++) step();
+
+    const AllocationStats before = AllocationTracking::Read();
+    for (int t = 0; t < MeasuredTicks; t++) step();
+    const AllocationStats steady = AllocationTracking::Read() - before;
+
+    if (steady.Total().allocations == 0) {
+        std::printf("%s: %d steady-state steps, no allocations\n", name, MeasuredTicks);
+        return true;
+    }
+    std::fprintf(stderr, "%s: %d steady-state steps allocated\n", name, MeasuredTicks);
+    PrintAllocations("steady-state allocations:", steady);
+    return false;
+}
+
+static bool TestWorld() {
+    World<Real> world{1360, 765};
+    constexpr std::size_t bodies = 200;
+    world.Reserve(bodies);
+    SpawnSettings<Real> spawn{0, 0, world.width, world.Floor(), bodies, 10, 30};
+    spawn.maxSpeed = 500;
+    spawn.seed = 1;
+    world.Spawn(spawn);
+
+    CommandQueue<Real> input{256};
+    SimulationControl control;
+    TripleBuffer<RenderSnapshot<Real>> frames;
+    RewindBuffer<Real> rewind{WarmupTicks / 2};     // full before the measured steps start
+
+    return SteadyStateIsAllocationFree("World", [&] {
+        ApplyCommands(world, control, input);
+        if (!control.paused) {
+            world.Step();
+            rewind.Record(world);
+        }
+        CaptureSnapshot(world, frames.WriteBuffer());
+        frames.Publish();
+    });
+}
+
+static bool TestChunkedWorld() {
+    ChunkedWorld<Real> world{256, 600, 1200};
+    world.freezeInterval = 8;
+
+    // Two piles of touching circles at rest: one at the camera stays awake and keeps its contacts, the other is
+    // beyond freezeRadius and stays frozen in memory, so every sweep walks both without changing anything
+    for (const Real originX : {Real(-300), Real(20000)}) {
+        for (int row = 0; row < 16; row++) {
+            for (int column = 0; column < 16; column++) {
+                const Real x = originX + static_cast<Real>(column) * Real(7.8) + (row % 2 ? Real(3.9) : Real(0));
+                const Real y = static_cast<Real>(row) * Real(6.8) - 80;
+                Shape::Circle<Real> circle{x, y, 4};
+                world.AddBody(Object<Real>{x, y, 1, &circle});
+            }
+        }
+    }
+
+    const bool allocationFree = SteadyStateIsAllocationFree("ChunkedWorld", [&] { world.Step(); });
+    if (world.solver.contacts.empty() || world.AwakeChunkCount() == world.ChunkCount()) {
+        std::fprintf(stderr, "ChunkedWorld: scene is not what the test expects (%zu contacts, %zu of %zu chunks awake)\n",
+                     world.solver.contacts.size(), world.AwakeChunkCount(), world.ChunkCount());
+        return false;
+    }
+    return allocationFree;
+}
+
+int main() {
+    const bool world = TestWorld();
+    const bool chunked = TestChunkedWorld();
+    return world && chunked ? 0 : 1;
+}
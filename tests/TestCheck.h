@@ -0,0 +1,29 @@
+//
+// Created by HuyN on 10/19/2026.
+//
+#pragma once
+
+#include <cstdio>
+
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+// Shared by the test programs: CHECK reports a failed condition and keeps going, TestExitCode ends main
+
+inline int testFailures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            testFailures++; \
+        } \
+    } while (0)
+
+inline int TestExitCode(const char* name) {
+    if (testFailures) std::fprintf(stderr, "%s: %d check(s) failed\n", name, testFailures);
+    else std::printf("%s: all checks passed\n", name);
+    return testFailures ? 1 : 0;
+}
+
+#endif //TESTCHECK_H
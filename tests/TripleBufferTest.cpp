@@ -0,0 +1,93 @@
+// RULE: 1px = 1cm irl
+
+// Triple buffer: the reader gets the newest published state and keeps it until a newer one arrives; with the
+// writer on another thread, no read is ever torn, older than one seen before, or older than what was published
+// before the read began.
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "Precision.h"
+#include "StateBuffer.h"
+#include "TestCheck.h"
+
+using namespace HuyNPhysic;
+
+// Large enough that a copy racing with a read would show as words from two different states
+struct Stamp {
+    std::uint64_t sequence;
+    std::uint64_t words[256];
+};
+
+static void Fill(Stamp& stamp, const std::uint64_t sequence) {
+    stamp.sequence = sequence;
+    for (auto& w : stamp.words) w = sequence;
+}
+
+static bool Whole(const Stamp& stamp) {
+    for (const auto w : stamp.words) if (w != stamp.sequence) return false;
+    return true;
+}
+
+static void TestNewestWins() {
+    TripleBuffer<Stamp> buffer;
+    CHECK(!buffer.Acquire());
+
+    Fill(buffer.WriteBuffer(), 1);
+    buffer.Publish();
+    CHECK(buffer.Acquire());
+    CHECK(buffer.ReadBuffer().sequence == 1);
+    CHECK(!buffer.Acquire());
+    CHECK(buffer.ReadBuffer().sequence == 1);
+
+    // Two publishes between reads: the older one is skipped
+    for (std::uint64_t s = 2; s <= 3; s++) {
+        Fill(buffer.WriteBuffer(), s);
+        buffer.Publish();
+    }
+    CHECK(buffer.Acquire());
+    CHECK(buffer.ReadBuffer().sequence == 3);
+    CHECK(Whole(buffer.ReadBuffer()));
+    CHECK(!buffer.Acquire());
+}
+
+static void TestAcrossThreads() {
+    constexpr std::uint64_t Publishes = 200000;
+    TripleBuffer<Stamp> buffer;
+    std::atomic<std::uint64_t> published{0};
+
+    std::thread writer([&] {
+        for (std::uint64_t s = 1; s <= Publishes; s++) {
+            Fill(buffer.WriteBuffer(), s);
+            buffer.Publish();
+            published.store(s, std::memory_order_release);
+        }
+    });
+
+    std::uint64_t last = 0, reads = 0, torn = 0, backwards = 0, stale = 0, repeats = 0;
+    while (last < Publishes) {
+        const std::uint64_t before = published.load(std::memory_order_acquire);
+        const bool fresh = buffer.Acquire();
+        const Stamp& stamp = buffer.ReadBuffer();
+        reads++;
+        if (!Whole(stamp)) torn++;
+        if (stamp.sequence < last) backwards++;
+        if (stamp.sequence < before) stale++;
+        if (fresh && stamp.sequence == last) repeats++;
+        last = stamp.sequence;
+    }
+    writer.join();
+
+    CHECK(torn == 0);
+    CHECK(backwards == 0);
+    CHECK(stale == 0);
+    CHECK(repeats == 0);
+    CHECK(reads > 0);
+}
+
+int main() {
+    TestNewestWins();
+    TestAcrossThreads();
+    return TestExitCode("TripleBuffer");
+}